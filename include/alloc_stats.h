@@ -0,0 +1,132 @@
+#ifndef ALLOC_STATS_H_INCLUDED
+#define ALLOC_STATS_H_INCLUDED
+
+#include <stdio.h>
+
+/*
+Estatísticas de alocação de memória das Strings dinâmicas e das listas
+encadeadas. Só são coletadas se a biblioteca for compilada com
+CEMDUTIL_STATS definido (make STATS=1); caso contrário as funções abaixo
+continuam disponíveis, mas todos os contadores ficam zerados.
+
+Cada thread atualiza seus próprios contadores, que são somados apenas
+quando as estatísticas são consultadas
+*/
+
+/*
+Eventos registrados pelas estatísticas (também recebidos pelo hook)
+*/
+typedef enum en_alloc_stats_event {
+    ALLOC_STATS_ALLOCATION, // Novo buffer de String (bytes = tamanho)
+    ALLOC_STATS_REALLOCATION, // realloc de buffer de String (bytes = novo tamanho)
+    ALLOC_STATS_FREE, // Buffer de String removido da memória (bytes = tamanho)
+    ALLOC_STATS_COPY, // Cópia de caracteres para um buffer (bytes = quantidade copiada)
+    ALLOC_STATS_GROWTH, // Crescimento pela estratégia de realocação (bytes = espaço extra criado)
+    ALLOC_STATS_NODE_NEW, // Novo elemento de lista (bytes = tamanho)
+    ALLOC_STATS_NODE_FREE // Elemento de lista removido da memória (bytes = tamanho)
+} AllocStatsEvent;
+
+/*
+Estratégias de realocação contadas separadamente em AllocStats->growths
+*/
+typedef enum en_alloc_stats_strategy {
+    ALLOC_STATS_STRICT,
+    ALLOC_STATS_HALF,
+    ALLOC_STATS_DOUBLE,
+    ALLOC_STATS_OTHER, // Estratégias definidas pelo usuário
+    ALLOC_STATS_STRATEGIES
+} AllocStatsStrategy;
+
+/*
+Contadores de alocação de memória
+*/
+typedef struct st_alloc_stats {
+    long allocations; // Quantidade de malloc (buffers de String e elementos de lista)
+    long reallocations; // Quantidade de realloc de buffers de String
+    long frees; // Quantidade de free (buffers de String e elementos de lista)
+    long bytes_allocated; // Bytes pedidos em malloc e realloc
+    long bytes_copied; // Bytes copiados explicitamente (strcpy/memcpy) para buffers de String
+    long slack_bytes; // Espaço extra (__length_allocated - lenght) criado pelos crescimentos
+    long growths[ALLOC_STATS_STRATEGIES]; // Crescimentos por estratégia de realocação
+    long nodes_created; // Elementos de lista criados
+    long nodes_freed; // Elementos de lista removidos da memória
+    long live_nodes; // Elementos de lista ainda na memória (a cabeça das listas não é contada)
+} AllocStats;
+
+/*
+Função chamada a cada evento registrado, na thread que o gerou
+
+@param event - Evento registrado
+@param bytes - Quantidade de bytes do evento
+@param user - Valor informado em alloc_stats_set_hook
+*/
+typedef void AllocStatsHook(AllocStatsEvent event, long bytes, void* user);
+
+/*
+Registra um evento na thread atual. Usado internamente pela biblioteca por
+meio das macros ALLOC_STATS_RECORD e ALLOC_STATS_RECORD_GROWTH
+
+@param event - Evento a ser registrado
+@param bytes - Quantidade de bytes do evento
+*/
+void alloc_stats_record(AllocStatsEvent event, long bytes);
+
+/*
+Registra um crescimento de buffer de String na thread atual
+
+@param strategy - Estratégia de realocação usada
+@param slack - Espaço extra criado pelo crescimento
+*/
+void alloc_stats_record_growth(AllocStatsStrategy strategy, long slack);
+
+/*
+@return - 1 se a biblioteca foi compilada com CEMDUTIL_STATS (as
+    estatísticas são coletadas), 0 caso contrário
+*/
+short alloc_stats_enabled();
+
+/*
+Soma os contadores de todas as threads
+
+@param stats - Recebe a soma dos contadores
+*/
+void alloc_stats_get(AllocStats* stats);
+
+/*
+@param stats - Recebe os contadores da thread atual
+*/
+void alloc_stats_get_thread(AllocStats* stats);
+
+/*
+Zera os contadores de todas as threads. Eventos registrados por outras
+threads durante a chamada podem ser perdidos
+*/
+void alloc_stats_reset();
+
+/*
+Escreve a soma dos contadores de todas as threads em um arquivo
+
+@param file - Arquivo de destino (por exemplo, stdout)
+*/
+void alloc_stats_dump(FILE* file);
+
+/*
+Define a função chamada a cada evento registrado. A função e o valor são
+trocados juntos, então um evento nunca recebe o valor de outro hook. Como
+outra thread pode estar chamando o hook anterior, ele continua na memória
+(cada par função/valor é alocado uma única vez)
+
+@param hook - Função a ser chamada (NULL para remover)
+@param user - Valor repassado para a função
+*/
+void alloc_stats_set_hook(AllocStatsHook* hook, void* user);
+
+#ifdef CEMDUTIL_STATS
+#define ALLOC_STATS_RECORD(event, bytes) alloc_stats_record((event), (long) (bytes))
+#define ALLOC_STATS_RECORD_GROWTH(strategy, slack) alloc_stats_record_growth((strategy), (long) (slack))
+#else
+#define ALLOC_STATS_RECORD(event, bytes) ((void) 0)
+#define ALLOC_STATS_RECORD_GROWTH(strategy, slack) ((void) 0)
+#endif
+
+#endif // ALLOC_STATS_H_INCLUDED
@@ -3,10 +3,14 @@
 
 #include <string.h>
 #include <stdlib.h>
+#include <stdint.h>
 #define MAX(x, y) (((x) > (y)) ? (x) : (y))
 #define MIN(x, y) (((x) < (y)) ? (x) : (y))
 #define DEFAULT_MIN_EXTRA 20 // Quantidade mínima de espaço extra em realocações de memória
 #define DEFAULT_STRATEGY_REALLOCATED HALF_STRATEGY_REALLOCATED // Estratégia padrão de realocação de memória
+#define JOIN_STRING_PARALLEL_MIN_SIZE (4 * 1024 * 1024) // Tamanho mínimo (em bytes) para join_string_parallel usar threads
+
+struct st_linked_list; // LinkedList (linked_list.h), usada por join_linked_list_string
 
 /* Define o tipo de realocação que a String terá */
 typedef int ReallocateStrategy(int length_allocated, int lenght);
@@ -50,7 +54,7 @@ Struct que representa uma instância de uma String dinâmica
 */
 typedef struct st_string {
     // public
-    char* c_str; // String e formato C
+    char* c_str; // String e formato C (pode ser compartilhada, ver clone_string)
     int lenght; // Quantidade de caracteres da string
     int min_extra; // Quantidade mínima de espaço extra na realocação da String
     ReallocateStrategy* reallocate_strategy; // Estratégia de realocação de espaço
@@ -86,6 +90,19 @@ Construtor da string dinâmica
 */
 String* new_string(const char* s);
 
+/*
+Construtor da string dinâmica a partir de uma quantidade de caracteres, que
+não precisam terminar em \0. Aloca apenas o espaço necessário
+
+String->min_extra = DEFAULT_MIN_EXTRA # 20
+String->reallocate_strategy = DEFAULT_STRATEGY_REALLOCATED # HALF_STRATEGY_REALLOCATED
+
+@param s - Caracteres a serem copiados para String dinâmica
+@param len - Quantidade de caracteres
+@return Nova instância de String dinâmica
+*/
+String* new_string_chars(const char* s, int len);
+
 /*
 @param str - Instância da String dinâmicas
 @return - quantidade de espaço alocado para a String dinâmica
@@ -135,6 +152,17 @@ Atribui novo valor para a String dinâmica
 */
 short set_string(String* str, const char* s);
 
+/*
+Atribui novo valor para a String dinâmica a partir de uma quantidade de
+caracteres, que não precisam terminar em \0
+
+@param str - Instância da String dinâmica
+@param s - Caracteres a serem atribuídos a 'str'
+@param len - Quantidade de caracteres
+@return - 1 se foi executado com sucesso, 0 caso contrário
+*/
+short set_string_chars(String* str, const char* s, int len);
+
 /*
 Concatena a String dinâmica com um valor
 
@@ -144,6 +172,78 @@ Concatena a String dinâmica com um valor
 */
 short cat_string(String* str, const char* s);
 
+/*
+Concatena a String dinâmica com um texto formatado (mesmo formato de printf).
+O texto é escrito diretamente no espaço livre da String, que só é realocada
+(e o texto formatado novamente) se o espaço não for suficiente
+
+@param str - Instância da String dinâmica
+@param format - Formato do texto (printf)
+@return - 1 se foi executado com sucesso, 0 caso contrário
+*/
+short cat_format(String* str, const char* format, ...);
+
+/*
+Concatena um número inteiro em decimal na String dinâmica
+
+@param str - Instância da String dinâmica
+@param value - Número a ser concatenado
+@return - 1 se foi executado com sucesso, 0 caso contrário
+*/
+short cat_int64(String* str, int64_t value);
+
+/*
+Concatena um número inteiro sem sinal em decimal na String dinâmica
+
+@param str - Instância da String dinâmica
+@param value - Número a ser concatenado
+@return - 1 se foi executado com sucesso, 0 caso contrário
+*/
+short cat_uint64(String* str, uint64_t value);
+
+/*
+Concatena um número inteiro sem sinal em hexadecimal (minúsculo e sem
+prefixo "0x") na String dinâmica
+
+@param str - Instância da String dinâmica
+@param value - Número a ser concatenado
+@return - 1 se foi executado com sucesso, 0 caso contrário
+*/
+short cat_hex64(String* str, uint64_t value);
+
+/*
+Concatena um número real na String dinâmica com a menor quantidade de
+dígitos que, lida de volta (strtod), resulta no mesmo valor. Números
+inteiros e números com poucas casas decimais (os casos comuns) são escritos
+sem passar pelo printf. O separador decimal é sempre '.', independente do
+locale
+
+@param str - Instância da String dinâmica
+@param value - Número a ser concatenado
+@return - 1 se foi executado com sucesso, 0 caso contrário
+*/
+short cat_double(String* str, double value);
+
+/*
+Cria uma cópia da String dinâmica em O(1). As duas instâncias compartilham o
+mesmo buffer até que uma delas seja alterada (copy-on-write). O contador de
+referências do buffer é atômico, então cópias podem ser lidas por threads
+diferentes
+
+@param str - Instância da String dinâmica a ser copiada
+@return - Nova instância de String dinâmica
+*/
+String* clone_string(String* str);
+
+/*
+Garante que a String dinâmica possui um buffer próprio. Deve ser chamado
+antes de alterar str->c_str diretamente
+
+@param str - Instância da String dinâmica
+@return - 1 se o buffer precisou ser copiado, 0 caso contrário
+*/
+short detach_string(String* str);
+
 /*
 Remove a String dinâmica da memória
 
@@ -190,4 +290,46 @@ array devem estar desalocadas da memória
 */
 short split_string(String* str, String* target[], const char* sep);
 
+/*
+Altera uma String dinâmica para receber a junção de várias Strings
+dinâmicas, separadas por um separador (o inverso de "split_string"). O
+espaço necessário é calculado antes, então a String é realocada no máximo
+uma vez
+
+@param target - Instância que irá receber a junção. Se estiver em "parts",
+    nada é feito e 0 é retornado
+@param parts - Array das Strings dinâmicas a serem juntadas
+@param size - Tamanho do array
+@param sep - Separador colocado entre as partes
+@return - 1 se foi executado com sucesso, 0 caso contrário
+*/
+short join_string(String* target, String* parts[], int size, const char* sep);
+
+/*
+Igual ao "join_string", mas a cópia das partes é dividida entre "threads"
+threads. Junções menores que JOIN_STRING_PARALLEL_MIN_SIZE bytes são feitas
+na thread atual
+
+@param target - Instância que irá receber a junção. Se estiver em "parts",
+    nada é feito e 0 é retornado
+@param parts - Array das Strings dinâmicas a serem juntadas
+@param size - Tamanho do array
+@param sep - Separador colocado entre as partes
+@param threads - Quantidade máxima de threads
+@return - 1 se foi executado com sucesso, 0 caso contrário
+*/
+short join_string_parallel(String* target, String* parts[], int size, const char* sep, int threads);
+
+/*
+Igual ao "join_string", mas as partes são os valores (String*) de uma
+lista encadeada
+
+@param target - Instância que irá receber a junção. Se estiver na lista,
+    nada é feito e 0 é retornado
+@param linked_list - Lista cujos valores são Strings dinâmicas
+@param sep - Separador colocado entre as partes
+@return - 1 se foi executado com sucesso, 0 caso contrário
+*/
+short join_linked_list_string(String* target, struct st_linked_list* linked_list, const char* sep);
+
 #endif // DYNAMIC_STRING_H_INCLUDED
\ No newline at end of file
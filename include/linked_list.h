@@ -68,4 +68,22 @@ void* linked_list_remove_top(LinkedList* linked_list);
 // Remove e apaga da memória elemento do linked_list_top da lista
 void linked_list_eraser_top(LinkedList* linked_list);
 
+// Função que compara dois valores da lista. Retorna um valor negativo se o
+// primeiro vem antes, positivo se vem depois e 0 se forem equivalentes
+typedef int LinkedListComparator(void* a, void* b);
+
+// Quantidade mínima de elementos para que linked_list_sort_parallel use threads
+#define LINKED_LIST_PARALLEL_MIN_SIZE 65536
+
+// ordena a lista (merge sort estável e sem alocação de memória) religando os elementos
+void linked_list_sort(LinkedList* linked_list, LinkedListComparator* comparador);
+
+// move os elementos de "other" para a lista, ambas já ordenadas, mantendo a ordenação.
+// "other" fica vazia, mas continua alocada
+void linked_list_merge(LinkedList* linked_list, LinkedList* other, LinkedListComparator* comparador);
+
+// ordena a lista dividindo o trabalho entre "threads" threads. Listas pequenas
+// (menores que LINKED_LIST_PARALLEL_MIN_SIZE) são ordenadas na thread atual
+void linked_list_sort_parallel(LinkedList* linked_list, LinkedListComparator* comparador, int threads);
+
 #endif // LINKED_LIST_H_INCLUDED
\ No newline at end of file
@@ -0,0 +1,82 @@
+#ifndef STRING_MATCHER_H_INCLUDED
+#define STRING_MATCHER_H_INCLUDED
+
+#include "dynamic_string.h"
+
+/*
+Conjunto de padrões compilado para ser buscado de uma só vez em várias
+Strings dinâmicas. Se todos os padrões tiverem um único byte, a busca usa
+uma tabela de 256 bits (com SSSE3, 16 bytes são testados por vez); caso
+contrário usa um autômato de Aho-Corasick. Em ambos os casos o texto é
+percorrido uma única vez, independente da quantidade de padrões
+*/
+typedef struct st_string_matcher {
+    // private
+    int __size; // Quantidade de padrões
+    int* __lengths; // Quantidade de bytes de cada padrão
+    int __max_length; // Quantidade de bytes do maior padrão
+    unsigned char __bytes[32]; // Conjunto dos bytes (quando todos os padrões têm 1 byte)
+    int __byte_patterns[256]; // Padrão de cada byte do conjunto
+    unsigned char __low_nibbles[16]; // Grupos de cada nibble baixo (busca com SSSE3)
+    unsigned char __high_nibbles[16]; // Grupos de cada nibble alto (busca com SSSE3)
+    int __states; // Quantidade de estados do autômato (0 se não for usado)
+    int __classes; // Quantidade de classes de bytes do autômato
+    unsigned char __byte_classes[256]; // Classe de cada byte (0 para os bytes que não estão nos padrões)
+    int* __transitions; // Próximo estado para cada estado e classe [estado * __classes + classe]
+    int* __matches; // Maior padrão que termina em cada estado (-1 se nenhum)
+} StringMatcher;
+
+/*
+Construtor do conjunto de padrões
+
+@param patterns - Array dos padrões (não podem ser vazios)
+@param size - Tamanho do array
+@return - Nova instância de StringMatcher, ou NULL se não houver padrões,
+    algum padrão for vazio ou não houver memória para o autômato
+*/
+StringMatcher* new_string_matcher(const char* patterns[], int size);
+
+/*
+Remove o conjunto de padrões da memória
+
+@param matcher - Instância a ser removida
+*/
+void free_string_matcher(StringMatcher* matcher);
+
+/*
+Busca a primeira ocorrência de qualquer um dos padrões em uma String
+dinâmica. Se mais de um padrão começar na mesma posição, o maior é
+escolhido
+
+@param str - Instância da String dinâmica
+@param matcher - Conjunto de padrões
+@param start - Posição a partir da qual buscar
+@param pattern - Recebe a posição do padrão encontrado no array informado
+    em new_string_matcher (pode ser NULL)
+@return - Posição da ocorrência, ou -1 se nenhum padrão for encontrado
+*/
+int find_any(String* str, StringMatcher* matcher, int start, int* pattern);
+
+/*
+Retorna o tamanho do array necessário para armazenar o resultado do
+método "split_string_any"
+
+@param str - Instância da String dinâmica que será separada
+@param matcher - Conjunto de separadores
+@return - Tamanho do array que armazenará o resultado do split
+*/
+int size_split_string_any(String* str, StringMatcher* matcher);
+
+/*
+Igual ao "split_string", mas qualquer um dos padrões do conjunto é um
+separador
+
+@param str - Instância da String dinâmica que será separada
+@param target - Array que armazenará o resultado do split. O array deve
+    estar completamente desalocado da memória
+@param matcher - Conjunto de separadores
+@return - 1 se foi executado com sucesso, 0 caso contrário
+*/
+short split_string_any(String* str, String* target[], StringMatcher* matcher);
+
+#endif // STRING_MATCHER_H_INCLUDED
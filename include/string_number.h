@@ -0,0 +1,116 @@
+#ifndef STRING_NUMBER_H_INCLUDED
+#define STRING_NUMBER_H_INCLUDED
+
+#include <stdint.h>
+#include "dynamic_string.h"
+
+/*
+Resultado da conversão de um texto para número
+*/
+typedef enum en_number_parse_result {
+    NUMBER_PARSE_OK = 0, // Conversão executada com sucesso
+    NUMBER_PARSE_EMPTY, // Texto vazio
+    NUMBER_PARSE_INVALID, // Texto possui caracteres que não fazem parte do número
+    NUMBER_PARSE_OVERFLOW // Número não cabe no tipo de destino
+} NumberParseResult;
+
+/*
+Converte um texto em decimal ([+-]digitos) para inteiro. O texto inteiro
+precisa ser o número (espaços não são ignorados) e não depende do locale
+
+@param s - Texto a ser convertido (não precisa terminar em \0)
+@param len - Quantidade de caracteres do texto
+@param value - Recebe o número convertido
+@return - NUMBER_PARSE_OK se executado com sucesso, o erro caso contrário
+*/
+NumberParseResult chars_to_int64(const char* s, int len, int64_t* value);
+
+/*
+Converte um texto em decimal ([+]digitos) para inteiro sem sinal. O texto
+inteiro precisa ser o número (espaços não são ignorados) e não depende do locale
+
+@param s - Texto a ser convertido (não precisa terminar em \0)
+@param len - Quantidade de caracteres do texto
+@param value - Recebe o número convertido
+@return - NUMBER_PARSE_OK se executado com sucesso, o erro caso contrário
+*/
+NumberParseResult chars_to_uint64(const char* s, int len, uint64_t* value);
+
+/*
+Converte um texto ([+-]digitos[.digitos][(e|E)[+-]digitos], "inf" ou "nan")
+para número real. O separador decimal é sempre '.', independente do locale
+
+@param s - Texto a ser convertido (não precisa terminar em \0)
+@param len - Quantidade de caracteres do texto
+@param value - Recebe o número convertido
+@return - NUMBER_PARSE_OK se executado com sucesso, o erro caso contrário
+*/
+NumberParseResult chars_to_double(const char* s, int len, double* value);
+
+/*
+Converte uma String dinâmica para inteiro (ver chars_to_int64)
+
+@param str - Instância da String dinâmica
+@param value - Recebe o número convertido
+@return - NUMBER_PARSE_OK se executado com sucesso, o erro caso contrário
+*/
+NumberParseResult string_to_int64(String* str, int64_t* value);
+
+/*
+Converte uma String dinâmica para inteiro sem sinal (ver chars_to_uint64)
+
+@param str - Instância da String dinâmica
+@param value - Recebe o número convertido
+@return - NUMBER_PARSE_OK se executado com sucesso, o erro caso contrário
+*/
+NumberParseResult string_to_uint64(String* str, uint64_t* value);
+
+/*
+Converte uma String dinâmica para número real (ver chars_to_double)
+
+@param str - Instância da String dinâmica
+@param value - Recebe o número convertido
+@return - NUMBER_PARSE_OK se executado com sucesso, o erro caso contrário
+*/
+NumberParseResult string_to_double(String* str, double* value);
+
+/*
+Converte um array de Strings dinâmicas (por exemplo, o resultado de
+"split_string") para um array de inteiros
+
+@param strs - Array de Strings dinâmicas a serem convertidas
+@param size - Tamanho do array
+@param target - Array que receberá os números (com pelo menos "size" posições)
+@param index_error - Recebe a posição da primeira String que não pôde ser
+    convertida (pode ser NULL)
+@return - NUMBER_PARSE_OK se todas foram convertidas, o primeiro erro caso contrário
+*/
+NumberParseResult strings_to_int64(String* strs[], int size, int64_t target[], int* index_error);
+
+/*
+Converte um array de Strings dinâmicas (por exemplo, o resultado de
+"split_string") para um array de inteiros sem sinal
+
+@param strs - Array de Strings dinâmicas a serem convertidas
+@param size - Tamanho do array
+@param target - Array que receberá os números (com pelo menos "size" posições)
+@param index_error - Recebe a posição da primeira String que não pôde ser
+    convertida (pode ser NULL)
+@return - NUMBER_PARSE_OK se todas foram convertidas, o primeiro erro caso contrário
+*/
+NumberParseResult strings_to_uint64(String* strs[], int size, uint64_t target[], int* index_error);
+
+/*
+Converte um array de Strings dinâmicas (por exemplo, o resultado de
+"split_string") para um array de números reais
+
+@param strs - Array de Strings dinâmicas a serem convertidas
+@param size - Tamanho do array
+@param target - Array que receberá os números (com pelo menos "size" posições)
+@param index_error - Recebe a posição da primeira String que não pôde ser
+    convertida (pode ser NULL)
+@return - NUMBER_PARSE_OK se todas foram convertidas, o primeiro erro caso contrário
+*/
+NumberParseResult strings_to_double(String* strs[], int size, double target[], int* index_error);
+
+#endif // STRING_NUMBER_H_INCLUDED
@@ -0,0 +1,115 @@
+#ifndef UTF8_STRING_H_INCLUDED
+#define UTF8_STRING_H_INCLUDED
+
+#include "dynamic_string.h"
+
+#define UTF8_INDEX_STEP 64 // Quantidade de caracteres entre as posições guardadas no Utf8Index
+
+/*
+Índice das posições (em bytes) dos caracteres de uma String dinâmica em
+UTF-8, usado para acessar caracteres pela posição sem percorrer a String
+desde o início. O índice deve ser recriado se a String for alterada
+*/
+typedef struct st_utf8_index {
+    int* offsets; // Posição em bytes dos caracteres 0, UTF8_INDEX_STEP, 2*UTF8_INDEX_STEP, ...
+    int size; // Quantidade de posições em offsets
+    int lenght; // Quantidade de caracteres (code points) da String
+} Utf8Index;
+
+/*
+Verifica se um texto é UTF-8 válido (sem sequências incompletas, overlong,
+surrogates ou acima de U+10FFFF). Trechos ASCII são verificados 16 bytes
+por vez; com SSSE3 todo o texto é verificado 16 bytes por vez
+
+@param s - Texto a ser verificado
+@param len - Quantidade de bytes do texto
+@return - 1 se o texto é UTF-8 válido, 0 caso contrário
+*/
+short utf8_valid(const char* s, int len);
+
+/*
+Conta a quantidade de caracteres (code points) de um texto em UTF-8 válido
+
+@param s - Texto em UTF-8
+@param len - Quantidade de bytes do texto
+@return - Quantidade de caracteres
+*/
+int utf8_length(const char* s, int len);
+
+/*
+@param str - Instância da String dinâmica
+@return - 1 se a String dinâmica é UTF-8 válido, 0 caso contrário
+*/
+short utf8_valid_string(String* str);
+
+/*
+@param str - Instância da String dinâmica em UTF-8 válido
+@return - Quantidade de caracteres (code points) da String dinâmica
+*/
+int utf8_length_string(String* str);
+
+/*
+Cria o índice das posições dos caracteres de uma String dinâmica
+
+@param str - Instância da String dinâmica em UTF-8 válido
+@return - Novo índice
+*/
+Utf8Index* new_utf8_index(String* str);
+
+/*
+Remove o índice da memória
+
+@param index - Índice a ser removido
+*/
+void free_utf8_index(Utf8Index* index);
+
+/*
+Retorna a posição em bytes de um caractere de uma String dinâmica
+
+@param str - Instância da String dinâmica em UTF-8 válido
+@param position - Posição do caractere (code point). Pode ser igual à
+    quantidade de caracteres (retorna str->lenght)
+@param index - Índice criado para "str" por new_utf8_index (pode ser NULL)
+@return - Posição em bytes, ou -1 se "position" estiver fora da String
+*/
+int utf8_offset_string(String* str, int position, Utf8Index* index);
+
+/*
+Altera uma String dinâmica para receber uma substring de outra String
+dinâmica em UTF-8, com posições contadas em caracteres (code points)
+
+@param str - Instância da String dinâmica em UTF-8 válido
+@param target - Instância que irá receber a substring. Não pode ser a
+    mesma instância de str
+@param start - Posição inicial da substring (em caracteres)
+@param end - Posição final da substring (não incluso, em caracteres)
+@param index - Índice criado para "str" por new_utf8_index (pode ser NULL)
+@return - 1 se executado com sucesso, 0 caso contrário
+*/
+short utf8_sub_string(String* str, String* target, int start, int end, Utf8Index* index);
+
+/*
+Retorna o tamanho do array necessário para armazenar o resultado do
+método "utf8_split_string"
+
+@param str - Instância da String dinâmica em UTF-8 válido
+@param sep - Separador em UTF-8 válido
+@return - Tamanho do array que armazenará o resultado do split
+*/
+int utf8_size_split_string(String* str, const char* sep);
+
+/*
+Igual ao "split_string", mas um separador vazio separa a String dinâmica em
+caracteres (code points) e não em bytes. Com um separador não vazio nenhum
+caractere é partido, pois em UTF-8 válido o separador não pode começar no
+meio de um caractere
+
+@param str - Instância da String dinâmica em UTF-8 válido
+@param target - Array que armazenará o resultado do split. O array deve
+    estar completamente desalocado da memória
+@param sep - Separador em UTF-8 válido
+@return - 1 se foi executado com sucesso, 0 caso contrário
+*/
+short utf8_split_string(String* str, String* target[], const char* sep);
+
+#endif // UTF8_STRING_H_INCLUDED
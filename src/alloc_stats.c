@@ -0,0 +1,261 @@
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include "alloc_stats.h"
+
+// Atualiza um contador da thread atual. Apenas a thread dona escreve no
+// contador; o acesso atômico (sem lock) permite a leitura por outras threads
+#define ALLOC_STATS_ADD(counter, value) \
+    __atomic_store_n(&(counter), __atomic_load_n(&(counter), __ATOMIC_RELAXED) + (value), __ATOMIC_RELAXED)
+
+/*
+Contadores de uma thread, ligados em uma lista para serem somados
+*/
+typedef struct st_alloc_stats_thread {
+    AllocStats stats;
+    struct st_alloc_stats_thread* next;
+} AllocStatsThread;
+
+/*
+Hook e valor do usuário, publicados juntos por um único ponteiro
+*/
+typedef struct st_alloc_stats_hook_entry {
+    AllocStatsHook* hook;
+    void* user;
+    struct st_alloc_stats_hook_entry* next;
+} AllocStatsHookEntry;
+
+static pthread_mutex_t alloc_stats_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_once_t alloc_stats_once = PTHREAD_ONCE_INIT;
+static pthread_key_t alloc_stats_key;
+static AllocStatsThread* alloc_stats_threads = NULL;
+static AllocStats alloc_stats_retired; // Soma dos contadores de threads finalizadas
+static __thread AllocStatsThread* alloc_stats_current = NULL;
+static AllocStatsHookEntry* alloc_stats_hook = NULL;
+static AllocStatsHookEntry* alloc_stats_hook_entries = NULL; // Todos os hooks já definidos
+
+static void alloc_stats_add(AllocStats* target, AllocStats* stats);
+
+/*
+Chamado quando uma thread termina: os seus contadores são somados aos das
+threads finalizadas e removidos da lista
+
+@param arg - Contadores da thread (AllocStatsThread)
+*/
+static void alloc_stats_thread_exit(void* arg) {
+    AllocStatsThread* thread = (AllocStatsThread*) arg;
+    AllocStatsThread** it;
+
+    pthread_mutex_lock(&alloc_stats_mutex);
+    alloc_stats_add(&alloc_stats_retired, &thread->stats);
+    for (it = &alloc_stats_threads; *it != NULL; it = &(*it)->next) {
+        if (*it == thread) {
+            *it = thread->next;
+            break;
+        }
+    }
+    pthread_mutex_unlock(&alloc_stats_mutex);
+
+    // um evento registrado depois disso (por outro destrutor) cria novos contadores
+    alloc_stats_current = NULL;
+    free(thread);
+}
+
+static void alloc_stats_create_key() {
+    pthread_key_create(&alloc_stats_key, alloc_stats_thread_exit);
+}
+
+/*
+@return - Contadores da thread atual, criados no primeiro uso. Quando a
+    thread termina, os contadores são somados aos das threads finalizadas
+*/
+static AllocStats* alloc_stats_thread() {
+    if (alloc_stats_current == NULL) {
+        AllocStatsThread* thread = (AllocStatsThread*) calloc(1, sizeof(AllocStatsThread));
+        pthread_once(&alloc_stats_once, alloc_stats_create_key);
+        pthread_mutex_lock(&alloc_stats_mutex);
+        thread->next = alloc_stats_threads;
+        alloc_stats_threads = thread;
+        pthread_mutex_unlock(&alloc_stats_mutex);
+        pthread_setspecific(alloc_stats_key, thread);
+        alloc_stats_current = thread;
+    }
+
+    return &alloc_stats_current->stats;
+}
+
+/*
+Registra um evento na thread atual. Usado internamente pela biblioteca por
+meio das macros ALLOC_STATS_RECORD e ALLOC_STATS_RECORD_GROWTH
+
+@param event - Evento a ser registrado
+@param bytes - Quantidade de bytes do evento
+*/
+void alloc_stats_record(AllocStatsEvent event, long bytes) {
+    AllocStats* stats = alloc_stats_thread();
+
+    switch (event) {
+    case ALLOC_STATS_NODE_NEW:
+        ALLOC_STATS_ADD(stats->nodes_created, 1);
+        // fall through
+    case ALLOC_STATS_ALLOCATION:
+        ALLOC_STATS_ADD(stats->allocations, 1);
+        ALLOC_STATS_ADD(stats->bytes_allocated, bytes);
+        break;
+    case ALLOC_STATS_REALLOCATION:
+        ALLOC_STATS_ADD(stats->reallocations, 1);
+        ALLOC_STATS_ADD(stats->bytes_allocated, bytes);
+        break;
+    case ALLOC_STATS_NODE_FREE:
+        ALLOC_STATS_ADD(stats->nodes_freed, 1);
+        // fall through
+    case ALLOC_STATS_FREE:
+        ALLOC_STATS_ADD(stats->frees, 1);
+        break;
+    case ALLOC_STATS_COPY:
+        ALLOC_STATS_ADD(stats->bytes_copied, bytes);
+        break;
+    case ALLOC_STATS_GROWTH:
+        ALLOC_STATS_ADD(stats->slack_bytes, bytes);
+        break;
+    }
+
+    AllocStatsHookEntry* entry = __atomic_load_n(&alloc_stats_hook, __ATOMIC_ACQUIRE);
+    if (entry != NULL)
+        entry->hook(event, bytes, entry->user);
+}
+
+/*
+Registra um crescimento de buffer de String na thread atual
+
+@param strategy - Estratégia de realocação usada
+@param slack - Espaço extra criado pelo crescimento
+*/
+void alloc_stats_record_growth(AllocStatsStrategy strategy, long slack) {
+    AllocStats* stats = alloc_stats_thread();
+    ALLOC_STATS_ADD(stats->growths[strategy], 1);
+    alloc_stats_record(ALLOC_STATS_GROWTH, slack);
+}
+
+/*
+Soma um conjunto de contadores em outro
+
+@param target - Contadores que recebem a soma
+@param stats - Contadores a serem somados
+*/
+static void alloc_stats_add(AllocStats* target, AllocStats* stats) {
+    int i;
+    target->allocations += __atomic_load_n(&stats->allocations, __ATOMIC_RELAXED);
+    target->reallocations += __atomic_load_n(&stats->reallocations, __ATOMIC_RELAXED);
+    target->frees += __atomic_load_n(&stats->frees, __ATOMIC_RELAXED);
+    target->bytes_allocated += __atomic_load_n(&stats->bytes_allocated, __ATOMIC_RELAXED);
+    target->bytes_copied += __atomic_load_n(&stats->bytes_copied, __ATOMIC_RELAXED);
+    target->slack_bytes += __atomic_load_n(&stats->slack_bytes, __ATOMIC_RELAXED);
+    for (i = 0; i < ALLOC_STATS_STRATEGIES; i++)
+        target->growths[i] += __atomic_load_n(&stats->growths[i], __ATOMIC_RELAXED);
+    target->nodes_created += __atomic_load_n(&stats->nodes_created, __ATOMIC_RELAXED);
+    target->nodes_freed += __atomic_load_n(&stats->nodes_freed, __ATOMIC_RELAXED);
+    target->live_nodes = target->nodes_created - target->nodes_freed;
+}
+
+/*
+@return - 1 se a biblioteca foi compilada com CEMDUTIL_STATS (as
+    estatísticas são coletadas), 0 caso contrário
+*/
+short alloc_stats_enabled() {
+#ifdef CEMDUTIL_STATS
+    return 1;
+#else
+    return 0;
+#endif
+}
+
+/*
+Soma os contadores de todas as threads
+
+@param stats - Recebe a soma dos contadores
+*/
+void alloc_stats_get(AllocStats* stats) {
+    memset(stats, 0, sizeof(AllocStats));
+
+    pthread_mutex_lock(&alloc_stats_mutex);
+    alloc_stats_add(stats, &alloc_stats_retired);
+    AllocStatsThread* it;
+    for (it = alloc_stats_threads; it != NULL; it = it->next)
+        alloc_stats_add(stats, &it->stats);
+    pthread_mutex_unlock(&alloc_stats_mutex);
+}
+
+/*
+@param stats - Recebe os contadores da thread atual
+*/
+void alloc_stats_get_thread(AllocStats* stats) {
+    memset(stats, 0, sizeof(AllocStats));
+    if (alloc_stats_current != NULL)
+        alloc_stats_add(stats, &alloc_stats_current->stats);
+}
+
+/*
+Zera os contadores de todas as threads. Eventos registrados por outras
+threads durante a chamada podem ser perdidos
+*/
+void alloc_stats_reset() {
+    pthread_mutex_lock(&alloc_stats_mutex);
+    memset(&alloc_stats_retired, 0, sizeof(AllocStats));
+    AllocStatsThread* it;
+    for (it = alloc_stats_threads; it != NULL; it = it->next)
+        memset(&it->stats, 0, sizeof(AllocStats));
+    pthread_mutex_unlock(&alloc_stats_mutex);
+}
+
+/*
+Escreve a soma dos contadores de todas as threads em um arquivo
+
+@param file - Arquivo de destino (por exemplo, stdout)
+*/
+void alloc_stats_dump(FILE* file) {
+    AllocStats stats;
+    alloc_stats_get(&stats);
+
+    fprintf(file, "allocations:     %ld\n", stats.allocations);
+    fprintf(file, "reallocations:   %ld\n", stats.reallocations);
+    fprintf(file, "frees:           %ld\n", stats.frees);
+    fprintf(file, "bytes_allocated: %ld\n", stats.bytes_allocated);
+    fprintf(file, "bytes_copied:    %ld\n", stats.bytes_copied);
+    fprintf(file, "slack_bytes:     %ld\n", stats.slack_bytes);
+    fprintf(file, "growths:         strict=%ld half=%ld double=%ld other=%ld\n",
+        stats.growths[ALLOC_STATS_STRICT], stats.growths[ALLOC_STATS_HALF],
+        stats.growths[ALLOC_STATS_DOUBLE], stats.growths[ALLOC_STATS_OTHER]);
+    fprintf(file, "live_nodes:      %ld (%ld created, %ld freed)\n",
+        stats.live_nodes, stats.nodes_created, stats.nodes_freed);
+}
+
+/*
+Define a função chamada a cada evento registrado. A função e o valor são
+trocados juntos, então um evento nunca recebe o valor de outro hook. Como
+outra thread pode estar chamando o hook anterior, ele continua na memória
+(cada par função/valor é alocado uma única vez)
+
+@param hook - Função a ser chamada (NULL para remover)
+@param user - Valor repassado para a função
+*/
+void alloc_stats_set_hook(AllocStatsHook* hook, void* user) {
+    AllocStatsHookEntry* entry = NULL;
+
+    pthread_mutex_lock(&alloc_stats_mutex);
+    if (hook != NULL) {
+        for (entry = alloc_stats_hook_entries; entry != NULL; entry = entry->next)
+            if (entry->hook == hook && entry->user == user)
+                break;
+
+        if (entry == NULL) {
+            entry = (AllocStatsHookEntry*) malloc(sizeof(AllocStatsHookEntry));
+            entry->hook = hook;
+            entry->user = user;
+            entry->next = alloc_stats_hook_entries;
+            alloc_stats_hook_entries = entry;
+        }
+    }
+    __atomic_store_n(&alloc_stats_hook, entry, __ATOMIC_RELEASE);
+    pthread_mutex_unlock(&alloc_stats_mutex);
+}
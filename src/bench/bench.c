@@ -0,0 +1,200 @@
+#define _POSIX_C_SOURCE 199309L
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "bench.h"
+
+/*
+@return - Tempo atual em nanossegundos (relógio monotônico)
+*/
+static double bench_now() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static int bench_compare_double(const void* a, const void* b) {
+    double x = *(const double*) a;
+    double y = *(const double*) b;
+    return (x > y) - (x < y);
+}
+
+/*
+Cria um conjunto de benchmarks. Os argumentos aceitos são:
+    --json <arquivo>      escreve os resultados em JSON (um resultado por linha)
+    --baseline <arquivo>  compara as medianas com um JSON gerado anteriormente
+    --threshold <valor>   aumento relativo considerado regressão (padrão 0.1)
+    --warmup <n>          execuções descartadas antes das medições
+    --repetitions <n>     execuções medidas
+    --filter <texto>      executa apenas benchmarks cujo nome contém o texto
+
+@param argc - Quantidade de argumentos do executável
+@param argv - Argumentos do executável
+@param warmup - Quantidade padrão de execuções descartadas
+@param repetitions - Quantidade padrão de execuções medidas
+@return - Nova instância de BenchSuite
+*/
+BenchSuite* new_bench_suite(int argc, const char* argv[], int warmup, int repetitions) {
+    BenchSuite* suite = (BenchSuite*) malloc(sizeof(BenchSuite));
+    suite->warmup = warmup;
+    suite->repetitions = repetitions;
+    suite->filter = NULL;
+    suite->threshold = 0.1;
+    suite->__json = NULL;
+    suite->__count = 0;
+    suite->__baseline = NULL;
+    suite->__regressions = 0;
+
+    int i;
+    for (i = 1; i + 1 < argc; i += 2) {
+        if (strcmp(argv[i], "--json") == 0) {
+            suite->__json = fopen(argv[i + 1], "w");
+            if (suite->__json == NULL)
+                fprintf(stderr, "não foi possível criar %s\n", argv[i + 1]);
+        } else if (strcmp(argv[i], "--baseline") == 0) {
+            suite->__baseline = argv[i + 1];
+        } else if (strcmp(argv[i], "--threshold") == 0) {
+            suite->threshold = atof(argv[i + 1]);
+        } else if (strcmp(argv[i], "--warmup") == 0) {
+            suite->warmup = atoi(argv[i + 1]);
+        } else if (strcmp(argv[i], "--repetitions") == 0) {
+            suite->repetitions = atoi(argv[i + 1]);
+        } else if (strcmp(argv[i], "--filter") == 0) {
+            suite->filter = argv[i + 1];
+        } else {
+            fprintf(stderr, "argumento desconhecido: %s\n", argv[i]);
+        }
+    }
+
+    suite->repetitions = suite->repetitions < 1 ? 1 : suite->repetitions;
+
+    if (suite->__json != NULL)
+        fprintf(suite->__json, "[\n");
+
+    printf("%-40s %10s %14s %14s %14s\n", "benchmark", "size", "median(ns/op)", "p99(ns/op)", "baseline");
+    return suite;
+}
+
+/*
+Busca a mediana de um benchmark no JSON de uma execução anterior
+
+@param path - Caminho do JSON
+@param name - Nome do benchmark
+@param size - Tamanho da entrada do benchmark
+@return - Mediana em ns por operação, ou -1 se não encontrada
+*/
+static double bench_baseline_median(const char* path, const char* name, long size) {
+    FILE* file = fopen(path, "r");
+    if (file == NULL)
+        return -1;
+
+    char line[512];
+    char expected[300];
+    double median = -1;
+    snprintf(expected, sizeof(expected), "{\"name\": \"%s\", \"size\": %ld,", name, size);
+
+    while (fgets(line, sizeof(line), file) != NULL) {
+        if (strncmp(line, expected, strlen(expected)) != 0)
+            continue;
+
+        char* field = strstr(line, "\"median_ns\": ");
+        if (field != NULL)
+            median = atof(field + strlen("\"median_ns\": "));
+        break;
+    }
+
+    fclose(file);
+    return median;
+}
+
+/*
+Executa e mede um benchmark. Cada repetição chama "setup", mede "run" e
+chama "teardown". O tempo de cada repetição é dividido por "ops" para
+obter o tempo de cada operação
+
+@param suite - Conjunto de benchmarks
+@param name - Nome do benchmark
+@param size - Tamanho da entrada (apenas informativo)
+@param ops - Quantidade de operações executadas por "run"
+@param setup - Preparação de cada repetição, não medida (pode ser NULL)
+@param run - Função medida
+@param teardown - Limpeza de cada repetição, não medida (pode ser NULL)
+@param context - Contexto passado para as funções
+*/
+void bench_run(BenchSuite* suite, const char* name, long size, long ops,
+    BenchFunction* setup, BenchFunction* run, BenchFunction* teardown, void* context) {
+
+    if (suite->filter != NULL && strstr(name, suite->filter) == NULL)
+        return;
+
+    double times[suite->repetitions];
+    int i;
+
+    for (i = -suite->warmup; i < suite->repetitions; i++) {
+        if (setup != NULL)
+            setup(context);
+
+        double start = bench_now();
+        run(context);
+        double elapsed = bench_now() - start;
+
+        if (teardown != NULL)
+            teardown(context);
+
+        if (i >= 0)
+            times[i] = elapsed / (ops > 0 ? ops : 1);
+    }
+
+    qsort(times, suite->repetitions, sizeof(double), bench_compare_double);
+
+    int n = suite->repetitions;
+    double median = n % 2 ? times[n / 2] : (times[n / 2 - 1] + times[n / 2]) / 2;
+    int rank = (99 * n + 99) / 100; // percentil pelo método nearest-rank
+    double p99 = times[rank - 1];
+    double mean = 0;
+    for (i = 0; i < n; i++)
+        mean += times[i] / n;
+
+    char comparison[32] = "-";
+    if (suite->__baseline != NULL) {
+        double baseline = bench_baseline_median(suite->__baseline, name, size);
+        if (baseline > 0) {
+            double ratio = median / baseline;
+            short regression = ratio > 1 + suite->threshold;
+            snprintf(comparison, sizeof(comparison), "%+.1f%%%s", (ratio - 1) * 100, regression ? " !" : "");
+            suite->__regressions += regression;
+        }
+    }
+
+    printf("%-40s %10ld %14.1f %14.1f %14s\n", name, size, median, p99, comparison);
+    fflush(stdout);
+
+    if (suite->__json != NULL) {
+        fprintf(suite->__json,
+            "%s{\"name\": \"%s\", \"size\": %ld, \"ops\": %ld, \"repetitions\": %d, "
+            "\"median_ns\": %.3f, \"p99_ns\": %.3f, \"min_ns\": %.3f, \"max_ns\": %.3f, \"mean_ns\": %.3f}",
+            suite->__count > 0 ? ",\n" : "", name, size, ops, n, median, p99, times[0], times[n - 1], mean);
+        suite->__count++;
+    }
+}
+
+/*
+Finaliza o conjunto de benchmarks, fechando o JSON e removendo-o da memória
+
+@param suite - Conjunto de benchmarks
+@return - 0 se nenhum benchmark ficou mais lento que o baseline, 1 caso contrário
+*/
+int free_bench_suite(BenchSuite* suite) {
+    int regressions = suite->__regressions;
+
+    if (suite->__json != NULL) {
+        fprintf(suite->__json, "\n]\n");
+        fclose(suite->__json);
+    }
+
+    if (regressions > 0)
+        printf("%d benchmark(s) mais lentos que o baseline\n", regressions);
+
+    free(suite);
+    return regressions > 0;
+}
@@ -0,0 +1,70 @@
+#ifndef BENCH_H_INCLUDED
+#define BENCH_H_INCLUDED
+
+#include <stdio.h>
+
+/*
+Função executada pelo benchmark. Recebe o contexto informado em bench_run
+*/
+typedef void BenchFunction(void* context);
+
+/*
+Struct que representa um conjunto de benchmarks de um executável
+*/
+typedef struct st_bench_suite {
+    // public
+    int warmup; // Quantidade de execuções descartadas antes das medições
+    int repetitions; // Quantidade de execuções medidas
+    const char* filter; // Se não for NULL, executa apenas benchmarks cujo nome contém o filtro
+    double threshold; // Aumento relativo da mediana (em relação ao baseline) considerado regressão
+
+    // private
+    FILE* __json; // Arquivo onde os resultados são escritos em JSON (pode ser NULL)
+    int __count; // Quantidade de resultados escritos
+    const char* __baseline; // Caminho do JSON de uma execução anterior (pode ser NULL)
+    int __regressions; // Quantidade de benchmarks mais lentos que o baseline
+} BenchSuite;
+
+/*
+Cria um conjunto de benchmarks. Os argumentos aceitos são:
+    --json <arquivo>      escreve os resultados em JSON (um resultado por linha)
+    --baseline <arquivo>  compara as medianas com um JSON gerado anteriormente
+    --threshold <valor>   aumento relativo considerado regressão (padrão 0.1)
+    --warmup <n>          execuções descartadas antes das medições
+    --repetitions <n>     execuções medidas
+    --filter <texto>      executa apenas benchmarks cujo nome contém o texto
+
+@param argc - Quantidade de argumentos do executável
+@param argv - Argumentos do executável
+@param warmup - Quantidade padrão de execuções descartadas
+@param repetitions - Quantidade padrão de execuções medidas
+@return - Nova instância de BenchSuite
+*/
+BenchSuite* new_bench_suite(int argc, const char* argv[], int warmup, int repetitions);
+
+/*
+Executa e mede um benchmark. Cada repetição chama "setup", mede "run" e
+chama "teardown". O tempo de cada repetição é dividido por "ops" para
+obter o tempo de cada operação
+
+@param suite - Conjunto de benchmarks
+@param name - Nome do benchmark
+@param size - Tamanho da entrada (apenas informativo)
+@param ops - Quantidade de operações executadas por "run"
+@param setup - Preparação de cada repetição, não medida (pode ser NULL)
+@param run - Função medida
+@param teardown - Limpeza de cada repetição, não medida (pode ser NULL)
+@param context - Contexto passado para as funções
+*/
+void bench_run(BenchSuite* suite, const char* name, long size, long ops,
+    BenchFunction* setup, BenchFunction* run, BenchFunction* teardown, void* context);
+
+/*
+Finaliza o conjunto de benchmarks, fechando o JSON e removendo-o da memória
+
+@param suite - Conjunto de benchmarks
+@return - 0 se nenhum benchmark ficou mais lento que o baseline, 1 caso contrário
+*/
+int free_bench_suite(BenchSuite* suite);
+
+#endif // BENCH_H_INCLUDED
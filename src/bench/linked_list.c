@@ -0,0 +1,90 @@
+#include <stdio.h>
+#include "linked_list.h"
+#include "bench.h"
+
+#define MAX(x, y) (((x) > (y)) ? (x) : (y))
+
+/*
+Contexto compartilhado pelos benchmarks de lista encadeada
+*/
+typedef struct st_linked_list_bench {
+    LinkedList* linked_list;
+    int size;
+    int ops;
+    int value;
+} LinkedListBench;
+
+static void fill(LinkedListBench* bench) {
+    int i;
+    for (i = 0; i < bench->size; i++)
+        linked_list_add(bench->linked_list, &bench->value);
+}
+
+static void setup_empty(void* context) {
+    LinkedListBench* bench = (LinkedListBench*) context;
+    bench->linked_list = new_linked_list();
+}
+
+static void setup_full(void* context) {
+    LinkedListBench* bench = (LinkedListBench*) context;
+    setup_empty(context);
+    fill(bench);
+}
+
+static void teardown(void* context) {
+    LinkedListBench* bench = (LinkedListBench*) context;
+    while (bench->linked_list->size > 0)
+        linked_list_remove_top(bench->linked_list);
+    free(bench->linked_list->head);
+    free(bench->linked_list);
+}
+
+static void run_add(void* context) {
+    fill((LinkedListBench*) context);
+}
+
+// insere no meio da lista, percorrendo metade dos elementos a cada inserção
+static void run_add_at(void* context) {
+    LinkedListBench* bench = (LinkedListBench*) context;
+    int i;
+    for (i = 0; i < bench->ops; i++)
+        linked_list_add_at(bench->linked_list, &bench->value, bench->linked_list->size / 2);
+}
+
+static void run_find_by_index(void* context) {
+    LinkedListBench* bench = (LinkedListBench*) context;
+    unsigned int seed = 12345;
+    int i;
+    for (i = 0; i < bench->ops; i++) {
+        seed = seed * 1103515245 + 12345;
+        linked_list_find_by_index(bench->linked_list, (seed >> 1) % bench->size);
+    }
+}
+
+static void run_remove_top(void* context) {
+    LinkedListBench* bench = (LinkedListBench*) context;
+    int i;
+    for (i = 0; i < bench->size; i++)
+        linked_list_remove_top(bench->linked_list);
+}
+
+int main (int argc, const char* argv[]) {
+
+    BenchSuite* suite = new_bench_suite(argc, argv, 1, 5);
+    LinkedListBench bench;
+    int size;
+
+    for (size = 1000; size <= 10000000; size *= 10) {
+        bench.size = size;
+
+        bench_run(suite, "linked_list_add", size, size, setup_empty, run_add, teardown, &bench);
+        bench_run(suite, "linked_list_remove_top", size, size, setup_full, run_remove_top, teardown, &bench);
+
+        // operações O(n): a quantidade diminui com o tamanho para manter o tempo total
+        bench.ops = MAX(10, 10000000 / size);
+        bench_run(suite, "linked_list_add_at", size, bench.ops, setup_full, run_add_at, teardown, &bench);
+        bench_run(suite, "linked_list_find_by_index", size, bench.ops, setup_full, run_find_by_index, teardown, &bench);
+    }
+
+    return free_bench_suite(suite);
+}
@@ -0,0 +1,95 @@
+#include <stdio.h>
+#include "linked_list.h"
+#include "bench.h"
+
+/*
+Contexto compartilhado pelos benchmarks de ordenação
+*/
+typedef struct st_sort_bench {
+    LinkedList* linked_list;
+    LinkedList* other;
+    int* values;
+    int size;
+} SortBench;
+
+int compare_int(void* a, void* b) {
+    int x = *(int*) a;
+    int y = *(int*) b;
+    return (x > y) - (x < y);
+}
+
+// preenche a lista com valores pseudo-aleatórios (sempre a mesma sequência)
+static void setup(void* context) {
+    SortBench* bench = (SortBench*) context;
+    unsigned int seed = 12345;
+    int i;
+
+    bench->linked_list = new_linked_list();
+    for (i = 0; i < bench->size; i++) {
+        seed = seed * 1103515245 + 12345;
+        bench->values[i] = (int) (seed >> 1);
+        linked_list_add(bench->linked_list, &bench->values[i]);
+    }
+}
+
+// prepara duas listas ordenadas com metade dos elementos cada
+static void setup_merge(void* context) {
+    SortBench* bench = (SortBench*) context;
+    setup(context);
+    linked_list_sort(bench->linked_list, compare_int);
+
+    bench->other = new_linked_list();
+    while (bench->other->size < bench->size / 2)
+        linked_list_add(bench->other, linked_list_remove_top(bench->linked_list));
+}
+
+static void free_list(LinkedList* linked_list) {
+    while (linked_list->size > 0)
+        linked_list_remove_top(linked_list);
+    free(linked_list->head);
+    free(linked_list);
+}
+
+static void teardown(void* context) {
+    free_list(((SortBench*) context)->linked_list);
+}
+
+static void teardown_merge(void* context) {
+    SortBench* bench = (SortBench*) context;
+    free_list(bench->linked_list);
+    free_list(bench->other);
+}
+
+static void run_sort(void* context) {
+    linked_list_sort(((SortBench*) context)->linked_list, compare_int);
+}
+
+static void run_sort_parallel(void* context) {
+    linked_list_sort_parallel(((SortBench*) context)->linked_list, compare_int, 4);
+}
+
+static void run_merge(void* context) {
+    SortBench* bench = (SortBench*) context;
+    linked_list_merge(bench->linked_list, bench->other, compare_int);
+}
+
+int main (int argc, const char* argv[]) {
+
+    BenchSuite* suite = new_bench_suite(argc, argv, 0, 3);
+    SortBench bench;
+    int sizes[] = { 1000000, 10000000 };
+    int i;
+
+    for (i = 0; i < 2; i++) {
+        bench.size = sizes[i];
+        bench.values = (int*) malloc(sizeof(int) * bench.size);
+
+        bench_run(suite, "linked_list_sort", bench.size, bench.size, setup, run_sort, teardown, &bench);
+        bench_run(suite, "linked_list_sort_parallel/4", bench.size, bench.size, setup, run_sort_parallel, teardown, &bench);
+        bench_run(suite, "linked_list_merge", bench.size, bench.size, setup_merge, run_merge, teardown_merge, &bench);
+
+        free(bench.values);
+    }
+
+    return free_bench_suite(suite);
+}
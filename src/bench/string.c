@@ -0,0 +1,206 @@
+#include <stdio.h>
+#include "dynamic_string.h"
+#include "string_matcher.h"
+#include "bench.h"
+
+/*
+Contexto compartilhado pelos benchmarks de String dinâmica
+*/
+typedef struct st_string_bench {
+    char* text; // Texto de entrada com "size" caracteres
+    int size;
+    int ops;
+    const char* sep;
+    ReallocateStrategy* strategy;
+    String* str;
+    String* target;
+    String** parts;
+    int size_parts;
+    StringMatcher* matcher;
+} StringBench;
+
+// preenche o texto com palavras de 1 a 7 letras separadas por "sep"
+static void fill_text(StringBench* bench, const char* sep) {
+    int len_sep = strlen(sep);
+    int i = 0;
+    unsigned int seed = 12345;
+
+    while (i < bench->size) {
+        seed = seed * 1103515245 + 12345;
+        int word = 1 + (seed >> 16) % 7;
+        for (; word > 0 && i < bench->size; word--)
+            bench->text[i++] = 'a' + (seed >> 8) % 26;
+        if (len_sep > 0 && i + len_sep <= bench->size) {
+            memcpy(bench->text + i, sep, len_sep);
+            i += len_sep;
+        }
+    }
+
+    bench->text[bench->size] = '\0';
+}
+
+static void run_new_string(void* context) {
+    StringBench* bench = (StringBench*) context;
+    int i;
+    for (i = 0; i < bench->ops; i++)
+        free_string(new_string(bench->text));
+}
+
+static void setup_str(void* context) {
+    StringBench* bench = (StringBench*) context;
+    bench->str = new_string_reallocate_strategy("", DEFAULT_MIN_EXTRA, bench->strategy);
+    bench->target = new_string("");
+}
+
+static void teardown_str(void* context) {
+    StringBench* bench = (StringBench*) context;
+    free_string(bench->str);
+    free_string(bench->target);
+}
+
+static void run_set_string(void* context) {
+    StringBench* bench = (StringBench*) context;
+    int i;
+    for (i = 0; i < bench->ops; i++) {
+        set_string(bench->str, bench->text);
+        set_string(bench->str, "");
+    }
+}
+
+// concatena pedaços de 16 caracteres até a String ter "size" caracteres
+static void run_cat_string(void* context) {
+    StringBench* bench = (StringBench*) context;
+    int i;
+    for (i = 0; i < bench->ops; i++)
+        cat_string(bench->str, "0123456789abcdef");
+}
+
+static void setup_sub_string(void* context) {
+    StringBench* bench = (StringBench*) context;
+    setup_str(context);
+    set_string(bench->str, bench->text);
+}
+
+static void run_sub_string(void* context) {
+    StringBench* bench = (StringBench*) context;
+    int i;
+    for (i = 0; i < bench->ops; i++)
+        sub_string(bench->str, bench->target, bench->size / 4, bench->size / 4 * 3);
+}
+
+static void setup_split_string(void* context) {
+    StringBench* bench = (StringBench*) context;
+    setup_sub_string(context);
+    bench->size_parts = size_split_string(bench->str, bench->sep);
+    bench->parts = (String**) malloc(sizeof(String*) * MAX(1, bench->size_parts));
+}
+
+static void run_split_string(void* context) {
+    StringBench* bench = (StringBench*) context;
+    split_string(bench->str, bench->parts, bench->sep);
+}
+
+static void teardown_split_string(void* context) {
+    StringBench* bench = (StringBench*) context;
+    int i;
+    for (i = 0; i < bench->size_parts; i++)
+        free_string(bench->parts[i]);
+    free(bench->parts);
+    teardown_str(context);
+}
+
+static void setup_split_string_any(void* context) {
+    StringBench* bench = (StringBench*) context;
+    setup_sub_string(context);
+    bench->size_parts = size_split_string_any(bench->str, bench->matcher);
+    bench->parts = (String**) malloc(sizeof(String*) * MAX(1, bench->size_parts));
+}
+
+static void run_split_string_any(void* context) {
+    StringBench* bench = (StringBench*) context;
+    split_string_any(bench->str, bench->parts, bench->matcher);
+}
+
+static void setup_join_string(void* context) {
+    StringBench* bench = (StringBench*) context;
+    int i;
+    setup_str(context);
+    bench->parts = (String**) malloc(sizeof(String*) * bench->size_parts);
+    for (i = 0; i < bench->size_parts; i++)
+        bench->parts[i] = new_string("0123456789abcdef");
+}
+
+static void run_join_string(void* context) {
+    StringBench* bench = (StringBench*) context;
+    join_string(bench->str, bench->parts, bench->size_parts, ",");
+}
+
+int main (int argc, const char* argv[]) {
+
+    BenchSuite* suite = new_bench_suite(argc, argv, 2, 15);
+    StringBench bench;
+    int sizes[] = { 16, 256, 4096, 65536 };
+    int split_sizes[] = { 64, 1024, 8192 };
+    const char* seps[] = { ",", "::", "" };
+    const char* strategy_names[] = { "strict", "half", "double" };
+    ReallocateStrategy* strategies[] = { STRICT_STRATEGY_REALLOCATED, HALF_STRATEGY_REALLOCATED, DOUBLE_STRATEGY_REALLOCATED };
+    const char* byte_patterns[] = { ";", "|", "," };
+    const char* word_patterns[] = { "::", "->", "=>" };
+    const char** matcher_patterns[] = { byte_patterns, word_patterns };
+    const char* matcher_names[] = { "bytes", "words" };
+    char name[64];
+    int i, j;
+
+    for (i = 0; i < 4; i++) {
+        bench.size = sizes[i];
+        bench.text = (char*) malloc(bench.size + 1);
+        bench.strategy = DEFAULT_STRATEGY_REALLOCATED;
+        bench.ops = MAX(1, 1000000 / bench.size);
+        fill_text(&bench, ",");
+
+        bench_run(suite, "new_string", bench.size, bench.ops, NULL, run_new_string, NULL, &bench);
+        bench_run(suite, "set_string", bench.size, bench.ops, setup_str, run_set_string, teardown_str, &bench);
+        bench_run(suite, "sub_string", bench.size, bench.ops, setup_sub_string, run_sub_string, teardown_str, &bench);
+
+        // com STRICT cada cat_string realoca, então o custo cresce com o tamanho
+        bench.ops = bench.size / 16;
+        for (j = 0; j < 3; j++) {
+            bench.strategy = strategies[j];
+            snprintf(name, sizeof(name), "cat_string/%s", strategy_names[j]);
+            bench_run(suite, name, bench.size, bench.ops, setup_str, run_cat_string, teardown_str, &bench);
+        }
+
+        free(bench.text);
+    }
+
+    bench.strategy = DEFAULT_STRATEGY_REALLOCATED;
+    for (i = 0; i < 3; i++) {
+        bench.size = split_sizes[i];
+        bench.text = (char*) malloc(bench.size + 1);
+
+        for (j = 0; j < 3; j++) {
+            bench.sep = seps[j];
+            fill_text(&bench, bench.sep);
+            snprintf(name, sizeof(name), "split_string/'%s'", bench.sep);
+            bench_run(suite, name, bench.size, 1, setup_split_string, run_split_string, teardown_split_string, &bench);
+        }
+
+        // um separador de cada conjunto aparece no texto
+        for (j = 0; j < 2; j++) {
+            bench.matcher = new_string_matcher(matcher_patterns[j], 3);
+            fill_text(&bench, matcher_patterns[j][2]);
+            snprintf(name, sizeof(name), "split_string_any/%s", matcher_names[j]);
+            bench_run(suite, name, bench.size, 1, setup_split_string_any, run_split_string_any, teardown_split_string, &bench);
+            free_string_matcher(bench.matcher);
+        }
+
+        free(bench.text);
+    }
+
+    for (i = 100; i <= 100000; i *= 10) {
+        bench.size_parts = i;
+        bench_run(suite, "join_string", i, i, setup_join_string, run_join_string, teardown_split_string, &bench);
+    }
+
+    return free_bench_suite(suite);
+}
@@ -1,5 +1,142 @@
+#define _POSIX_C_SOURCE 200112L
 #include <math.h>
+#include <float.h>
+#include <stdio.h>
+#include <locale.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <stdarg.h>
 #include "dynamic_string.h"
+#include "linked_list.h"
+#include "alloc_stats.h"
+
+/*
+Cabeçalho guardado na memória logo antes de String->c_str. Várias Strings
+podem apontar para o mesmo buffer (clone_string), que só é copiado quando
+uma delas for alterada
+*/
+typedef struct st_string_buffer {
+    int references; // Quantidade de Strings que usam o buffer (atômico)
+} StringBuffer;
+
+#define STRING_BUFFER(c_str) (((StringBuffer*) (c_str)) - 1)
+
+#ifdef CEMDUTIL_STATS
+/*
+@param strategy - Estratégia de realocação de uma String
+@return - Categoria da estratégia nas estatísticas de alocação
+*/
+static AllocStatsStrategy string_stats_strategy(ReallocateStrategy* strategy) {
+    if (strategy == STRICT_STRATEGY_REALLOCATED)
+        return ALLOC_STATS_STRICT;
+    if (strategy == HALF_STRATEGY_REALLOCATED)
+        return ALLOC_STATS_HALF;
+    if (strategy == DOUBLE_STRATEGY_REALLOCATED)
+        return ALLOC_STATS_DOUBLE;
+    return ALLOC_STATS_OTHER;
+}
+
+#define STRING_STATS_GROWTH(str, length_allocated, lenght) \
+    ALLOC_STATS_RECORD_GROWTH(string_stats_strategy((str)->reallocate_strategy), (length_allocated) - (lenght))
+#else
+#define STRING_STATS_GROWTH(str, length_allocated, lenght) ((void) 0)
+#endif
+
+/*
+Aloca um novo buffer com uma única referência
+
+@param length_allocated - espaço para os caracteres (incluindo o \0)
+@return - ponteiro para os caracteres do buffer
+*/
+static char* string_buffer_alloc(int length_allocated) {
+    StringBuffer* buffer = (StringBuffer*) malloc(sizeof(StringBuffer) + sizeof(char) * length_allocated);
+    buffer->references = 1;
+    ALLOC_STATS_RECORD(ALLOC_STATS_ALLOCATION, length_allocated);
+    return (char*) (buffer + 1);
+}
+
+/*
+Libera uma referência do buffer, removendo-o da memória se não houver
+mais nenhuma String usando-o
+
+@param c_str - caracteres do buffer
+@param length_allocated - espaço do buffer (usado apenas nas estatísticas)
+*/
+static void string_buffer_release(char* c_str, int length_allocated) {
+    if (__atomic_sub_fetch(&STRING_BUFFER(c_str)->references, 1, __ATOMIC_ACQ_REL) == 0) {
+        free(STRING_BUFFER(c_str));
+        ALLOC_STATS_RECORD(ALLOC_STATS_FREE, length_allocated);
+    }
+}
+
+/*
+@param str - String dinâmica
+@return - 1 se o buffer da String é usado por outras Strings, 0 caso contrário
+*/
+static short string_buffer_shared(String* str) {
+    return __atomic_load_n(&STRING_BUFFER(str->c_str)->references, __ATOMIC_ACQUIRE) > 1;
+}
+
+/*
+Realoca o buffer da String. Se o buffer for compartilhado, a String passa a
+ter um buffer próprio com uma cópia do seu conteúdo
+
+@param str - String dinâmica
+@param length_allocated - novo espaço do buffer. Deve ser maior que str->lenght
+*/
+static void string_buffer_realloc(String* str, int length_allocated) {
+    if (string_buffer_shared(str)) {
+        char* c_str = string_buffer_alloc(length_allocated);
+        memcpy(c_str, str->c_str, sizeof(char) * (str->lenght + 1));
+        ALLOC_STATS_RECORD(ALLOC_STATS_COPY, str->lenght + 1);
+        string_buffer_release(str->c_str, str->__length_allocated);
+        str->c_str = c_str;
+    } else {
+        StringBuffer* buffer = (StringBuffer*) realloc(STRING_BUFFER(str->c_str), sizeof(StringBuffer) + sizeof(char) * length_allocated);
+        str->c_str = (char*) (buffer + 1);
+        ALLOC_STATS_RECORD(ALLOC_STATS_REALLOCATION, length_allocated);
+    }
+
+    str->__length_allocated = length_allocated;
+}
+
+/*
+Troca o buffer compartilhado da String por um buffer próprio sem copiar o
+conteúdo, que será sobrescrito
+
+@param str - String dinâmica cujo buffer é compartilhado
+@param length_allocated - espaço do novo buffer
+*/
+static void string_buffer_discard(String* str, int length_allocated) {
+    char* c_str = string_buffer_alloc(length_allocated);
+    string_buffer_release(str->c_str, str->__length_allocated);
+    str->c_str = c_str;
+    str->__length_allocated = length_allocated;
+}
+
+/*
+Garante que a String possui um buffer próprio com espaço para "lenght"
+caracteres (mais o \0), realocando pela estratégia da String se necessário
+
+@param str - String dinâmica
+@param lenght - quantidade de caracteres que o buffer deve comportar
+*/
+static void string_reserve(String* str, int lenght) {
+    int length_allocated = str->__length_allocated;
+
+    if (length_allocated > lenght) {
+        if (string_buffer_shared(str))
+            string_buffer_realloc(str, length_allocated);
+        return;
+    }
+
+    while (length_allocated <= lenght)
+        length_allocated = str->reallocate_strategy(length_allocated, lenght);
+
+    length_allocated = MAX(length_allocated, (lenght+1) + (str->min_extra));
+    STRING_STATS_GROWTH(str, length_allocated, lenght);
+    string_buffer_realloc(str, length_allocated);
+}
 
 /*
 Cria uma estratégia de realocar apenas o espaço necessário pelo
@@ -67,8 +204,9 @@ String* new_string_reallocate_strategy(const char* s, int min_extra, ReallocateS
     }
 
     str->__length_allocated = MAX(str->__length_allocated, (str->lenght+1) + (str->min_extra));
-    str->c_str = (char*) malloc(sizeof(char) * str->__length_allocated);
+    str->c_str = string_buffer_alloc(str->__length_allocated);
     strcpy(str->c_str, s);
+    ALLOC_STATS_RECORD(ALLOC_STATS_COPY, str->lenght + 1);
     return str;
 }
 
@@ -91,8 +229,9 @@ String* new_string_allocated(const char* s, int min_length_allocated) {
     str->__length_allocated = 0;
     str->__length_allocated = STRICT_STRATEGY_REALLOCATED(str->__length_allocated, str->lenght);
     str->__length_allocated = MAX(str->__length_allocated, min_length_allocated);
-    str->c_str = (char*) malloc(sizeof(char) * str->__length_allocated);
+    str->c_str = string_buffer_alloc(str->__length_allocated);
     strcpy(str->c_str, s);
+    ALLOC_STATS_RECORD(ALLOC_STATS_COPY, str->lenght + 1);
     return str;
 }
 
@@ -109,6 +248,30 @@ String* new_string(const char* s) {
     return new_string_reallocate_strategy(s, DEFAULT_MIN_EXTRA, DEFAULT_STRATEGY_REALLOCATED);
 }
 
+/*
+Construtor da string dinâmica a partir de uma quantidade de caracteres, que
+não precisam terminar em \0. Aloca apenas o espaço necessário
+
+String->min_extra = DEFAULT_MIN_EXTRA # 20
+String->reallocate_strategy = DEFAULT_STRATEGY_REALLOCATED # HALF_STRATEGY_REALLOCATED
+
+@param s - Caracteres a serem copiados para String dinâmica
+@param len - Quantidade de caracteres
+@return Nova instância de String dinâmica
+*/
+String* new_string_chars(const char* s, int len) {
+    String* str = (String*) malloc(sizeof(String));
+    str->min_extra = DEFAULT_MIN_EXTRA;
+    str->reallocate_strategy = DEFAULT_STRATEGY_REALLOCATED;
+    str->lenght = len;
+    str->__length_allocated = STRICT_STRATEGY_REALLOCATED(0, len);
+    str->c_str = string_buffer_alloc(str->__length_allocated);
+    memcpy(str->c_str, s, sizeof(char) * len);
+    str->c_str[len] = '\0';
+    ALLOC_STATS_RECORD(ALLOC_STATS_COPY, len);
+    return str;
+}
+
 /*
 @param str - Instância da String dinâmicas
 @return - quantidade de espaço alocado para a String dinâmica
@@ -130,8 +293,7 @@ short set_min__length_allocated(String* str, int length_allocated) {
     if (str->__length_allocated >= length_allocated)
         return 0;
     
-    str->c_str = (char*) realloc(str->c_str, sizeof(char) * length_allocated);
-    str->__length_allocated = length_allocated;
+    string_buffer_realloc(str, length_allocated);
     return 1;
 }
 
@@ -148,8 +310,7 @@ short set_max__length_allocated(String* str, int length_allocated) {
     if (str->__length_allocated <= length_allocated || str->lenght >= length_allocated)
         return 0;
     
-    str->c_str = (char*) realloc(str->c_str, sizeof(char) * length_allocated);
-    str->__length_allocated = length_allocated;
+    string_buffer_realloc(str, length_allocated);
     return 1;
 }
 
@@ -167,8 +328,7 @@ short set__length_allocated(String* str, int length_allocated) {
     if (str->lenght >= length_allocated)
         return 0;
 
-    str->c_str = (char*) realloc(str->c_str, sizeof(char) * length_allocated);
-    str->__length_allocated = length_allocated;
+    string_buffer_realloc(str, length_allocated);
     return 1;
 }
 
@@ -180,20 +340,43 @@ Atribui novo valor para a String dinâmica
 @return - 1 se foi executado com sucesso, 0 caso contrário
 */
 short set_string(String* str, const char* s) {
-    str->lenght = strlen(s);
+    return set_string_chars(str, s, strlen(s));
+}
+
+/*
+Atribui novo valor para a String dinâmica a partir de uma quantidade de
+caracteres, que não precisam terminar em \0
+
+@param str - Instância da String dinâmica
+@param s - Caracteres a serem atribuídos a 'str'
+@param len - Quantidade de caracteres
+@return - 1 se foi executado com sucesso, 0 caso contrário
+*/
+short set_string_chars(String* str, const char* s, int len) {
+    int length_allocated = str->__length_allocated;
     int flag = 0;
 
-    while (str->__length_allocated <= str->lenght) {
-        str->__length_allocated = str->reallocate_strategy(str->__length_allocated, str->lenght);
+    while (length_allocated <= len) {
+        length_allocated = str->reallocate_strategy(length_allocated, len);
         flag = 1;
     }
 
     if (flag) {
-        str->__length_allocated = MAX(str->__length_allocated, (str->lenght+1) + (str->min_extra));
-        str->c_str = (char*) realloc(str->c_str, sizeof(char) * str->__length_allocated);
+        length_allocated = MAX(length_allocated, (len+1) + (str->min_extra));
+        STRING_STATS_GROWTH(str, length_allocated, len);
     }
 
-    strcpy(str->c_str, s);
+    if (string_buffer_shared(str)) {
+        // o conteúdo atual será descartado, então não precisa ser copiado
+        string_buffer_discard(str, length_allocated);
+    } else if (flag) {
+        string_buffer_realloc(str, length_allocated);
+    }
+
+    str->lenght = len;
+    memmove(str->c_str, s, sizeof(char) * len);
+    str->c_str[len] = '\0';
+    ALLOC_STATS_RECORD(ALLOC_STATS_COPY, len + 1);
     return 1;
 }
 
@@ -214,6 +397,274 @@ short cat_string(String* str, const char* s) {
     return 1;
 }
 
+/*
+Concatena a String dinâmica com um texto formatado (mesmo formato de printf).
+O texto é escrito diretamente no espaço livre da String, que só é realocada
+(e o texto formatado novamente) se o espaço não for suficiente
+
+@param str - Instância da String dinâmica
+@param format - Formato do texto (printf)
+@return - 1 se foi executado com sucesso, 0 caso contrário
+*/
+short cat_format(String* str, const char* format, ...) {
+    va_list args;
+    va_list retry;
+
+    string_reserve(str, str->lenght);
+    int free_space = str->__length_allocated - str->lenght;
+
+    va_start(args, format);
+    va_copy(retry, args);
+    int len = vsnprintf(str->c_str + str->lenght, free_space, format, args);
+    va_end(args);
+
+    if (len >= free_space) {
+        string_reserve(str, str->lenght + len);
+        vsnprintf(str->c_str + str->lenght, len + 1, format, retry);
+    }
+    va_end(retry);
+
+    if (len < 0) {
+        str->c_str[str->lenght] = '\0';
+        return 0;
+    }
+
+    ALLOC_STATS_RECORD(ALLOC_STATS_COPY, len);
+    str->lenght += len;
+    return 1;
+}
+
+/*
+Concatena os caracteres de um buffer na String dinâmica
+
+@param str - Instância da String dinâmica
+@param s - Caracteres a serem concatenados
+@param len - Quantidade de caracteres
+*/
+static void cat_chars(String* str, const char* s, int len) {
+    string_reserve(str, str->lenght + len);
+    memcpy(str->c_str + str->lenght, s, len);
+    ALLOC_STATS_RECORD(ALLOC_STATS_COPY, len);
+    str->lenght += len;
+    str->c_str[str->lenght] = '\0';
+}
+
+static const char DECIMAL_DIGITS_PAIRS[] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
+/*
+Escreve os dígitos decimais de um número no final de um buffer
+
+@param end - posição logo após o último dígito
+@param value - número a ser escrito
+@return - posição do primeiro dígito escrito
+*/
+static char* write_uint64(char* end, uint64_t value) {
+    while (value >= 100) {
+        int pair = (int) (value % 100) * 2;
+        value /= 100;
+        *--end = DECIMAL_DIGITS_PAIRS[pair + 1];
+        *--end = DECIMAL_DIGITS_PAIRS[pair];
+    }
+
+    if (value >= 10) {
+        int pair = (int) value * 2;
+        *--end = DECIMAL_DIGITS_PAIRS[pair + 1];
+        *--end = DECIMAL_DIGITS_PAIRS[pair];
+    } else {
+        *--end = (char) ('0' + value);
+    }
+
+    return end;
+}
+
+/*
+Concatena um número inteiro sem sinal em decimal na String dinâmica
+
+@param str - Instância da String dinâmica
+@param value - Número a ser concatenado
+@return - 1 se foi executado com sucesso, 0 caso contrário
+*/
+short cat_uint64(String* str, uint64_t value) {
+    char buffer[20];
+    char* start = write_uint64(buffer + sizeof(buffer), value);
+    cat_chars(str, start, buffer + sizeof(buffer) - start);
+    return 1;
+}
+
+/*
+Concatena um número inteiro em decimal na String dinâmica
+
+@param str - Instância da String dinâmica
+@param value - Número a ser concatenado
+@return - 1 se foi executado com sucesso, 0 caso contrário
+*/
+short cat_int64(String* str, int64_t value) {
+    char buffer[21];
+    uint64_t abs_value = value < 0 ? -(uint64_t) value : (uint64_t) value;
+    char* start = write_uint64(buffer + sizeof(buffer), abs_value);
+    if (value < 0)
+        *--start = '-';
+    cat_chars(str, start, buffer + sizeof(buffer) - start);
+    return 1;
+}
+
+/*
+Concatena um número inteiro sem sinal em hexadecimal (minúsculo e sem
+prefixo "0x") na String dinâmica
+
+@param str - Instância da String dinâmica
+@param value - Número a ser concatenado
+@return - 1 se foi executado com sucesso, 0 caso contrário
+*/
+short cat_hex64(String* str, uint64_t value) {
+    static const char digits[] = "0123456789abcdef";
+    char buffer[16];
+    char* start = buffer + sizeof(buffer);
+
+    do {
+        *--start = digits[value & 0xf];
+        value >>= 4;
+    } while (value != 0);
+
+    cat_chars(str, start, buffer + sizeof(buffer) - start);
+    return 1;
+}
+
+/*
+Concatena um número real na String dinâmica com a menor quantidade de
+dígitos que, lida de volta (strtod), resulta no mesmo valor. Números
+inteiros e números com poucas casas decimais (os casos comuns) são escritos
+sem passar pelo printf. O separador decimal é sempre '.', independente do
+locale
+
+@param str - Instância da String dinâmica
+@param value - Número a ser concatenado
+@return - 1 se foi executado com sucesso, 0 caso contrário
+*/
+short cat_double(String* str, double value) {
+    static const double powers[] = {
+        1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15
+    };
+    const double max_exact = 9007199254740992.0; // 2^53
+
+    if (isnan(value))
+        return cat_format(str, "nan");
+
+    if (isinf(value))
+        return cat_format(str, value < 0 ? "-inf" : "inf");
+
+    char buffer[40];
+    char* end = buffer + sizeof(buffer);
+    double abs_value = fabs(value);
+    int k;
+
+    // value == m / 10^k com m inteiro e exato em um double: a divisão é
+    // corretamente arredondada, então strtod da forma decimal resulta em value
+    for (k = 0; k < 16 && abs_value * powers[k] < max_exact; k++) {
+        double m = floor(abs_value * powers[k] + 0.5);
+        if (m / powers[k] != abs_value)
+            continue;
+
+        uint64_t digits = (uint64_t) m;
+        char* start = end;
+        if (k > 0) {
+            int i;
+            for (i = 0; i < k; i++) {
+                *--start = (char) ('0' + digits % 10);
+                digits /= 10;
+            }
+            *--start = '.';
+        }
+        start = write_uint64(start, digits);
+        if (signbit(value))
+            *--start = '-';
+
+        cat_chars(str, start, end - start);
+        return 1;
+    }
+
+    // números muito grandes, muito pequenos ou com muitos dígitos. Com 15
+    // dígitos o printf já remove os zeros à direita, então o resultado só
+    // não é o menor possível em subnormais, que têm menos precisão
+    int precision = 15;
+    int len = snprintf(buffer, sizeof(buffer), "%.*g", precision, value);
+    if (strtod(buffer, NULL) == value) {
+        if (fabs(value) < DBL_MIN) {
+            int low = 1;
+            int high = 15;
+            while (low < high) {
+                precision = (low + high) / 2;
+                snprintf(buffer, sizeof(buffer), "%.*g", precision, value);
+                if (strtod(buffer, NULL) == value)
+                    high = precision;
+                else
+                    low = precision + 1;
+            }
+            len = snprintf(buffer, sizeof(buffer), "%.*g", low, value);
+        }
+    } else {
+        len = snprintf(buffer, sizeof(buffer), "%.*g", 16, value);
+        if (strtod(buffer, NULL) != value)
+            len = snprintf(buffer, sizeof(buffer), "%.*g", 17, value);
+    }
+
+    // o printf escreve o separador decimal do locale atual, mas o resultado
+    // deve ser sempre '.' (como no caminho sem printf)
+    const char* point = localeconv()->decimal_point;
+    int len_point = strlen(point);
+    char* found;
+    if (len_point > 0 && strcmp(point, ".") != 0 && (found = strstr(buffer, point)) != NULL) {
+        *found = '.';
+        memmove(found + 1, found + len_point, len - (found - buffer) - len_point + 1);
+        len -= len_point - 1;
+    }
+
+    cat_chars(str, buffer, len);
+    return 1;
+}
+
+/*
+Cria uma cópia da String dinâmica em O(1). As duas instâncias compartilham o
+mesmo buffer até que uma delas seja alterada (copy-on-write). O contador de
+referências do buffer é atômico, então cópias podem ser lidas por threads
+diferentes
+
+@param str - Instância da String dinâmica a ser copiada
+@return - Nova instância de String dinâmica
+*/
+String* clone_string(String* str) {
+    String* clone = (String*) malloc(sizeof(String));
+    *clone = *str;
+    __atomic_add_fetch(&STRING_BUFFER(str->c_str)->references, 1, __ATOMIC_RELAXED);
+    return clone;
+}
+
+/*
+Garante que a String dinâmica possui um buffer próprio. Deve ser chamado
+antes de alterar str->c_str diretamente
+
+@param str - Instância da String dinâmica
+@return - 1 se o buffer precisou ser copiado, 0 caso contrário
+*/
+short detach_string(String* str) {
+    if (!string_buffer_shared(str))
+        return 0;
+
+    string_buffer_realloc(str, str->__length_allocated);
+    return 1;
+}
+
 /*
 Remove a String dinâmica da memória
 
@@ -221,9 +672,9 @@ Remove a String dinâmica da memória
 @return - 1 se foi executado com sucesso, 0 caso contrário
 */
 short free_string(String* str) {
+    string_buffer_release(str->c_str, str->__length_allocated);
     str->__length_allocated = 0;
     str->lenght = 0;
-    free(str->c_str);
     free(str);
     return 1;
 }
@@ -259,6 +710,7 @@ short sub_string(String* str, String* target, int start, int end) {
 
     target->c_str[len_sub] = '\0';
     target->lenght = len_sub;
+    ALLOC_STATS_RECORD(ALLOC_STATS_COPY, len_sub);
     return 1;
 }
 
@@ -341,3 +793,212 @@ short split_string(String* str, String* target[], const char* sep) {
     free_string(sub);
     return 1;
 }
+
+/*
+Prepara uma String dinâmica para receber uma junção, alocando no máximo um
+buffer (o conteúdo atual é descartado, então não é copiado)
+
+@param target - Instância que irá receber a junção
+@param lenght - Quantidade de caracteres da junção
+*/
+static void join_string_reserve(String* target, int lenght) {
+    if (string_buffer_shared(target)) {
+        string_buffer_discard(target, MAX(target->__length_allocated, lenght + 1));
+    } else if (target->__length_allocated <= lenght) {
+        target->lenght = 0;
+        string_buffer_realloc(target, lenght + 1);
+    }
+
+    target->c_str[lenght] = '\0';
+    target->lenght = lenght;
+    ALLOC_STATS_RECORD(ALLOC_STATS_COPY, lenght);
+}
+
+/*
+Copia as partes [first, last) de uma junção. Antes de cada parte, menos a
+primeira do array, é copiado o separador
+
+@param dest - Posição da junção onde a cópia começa
+@param parts - Array das Strings dinâmicas a serem juntadas
+@param first - Primeira parte a ser copiada
+@param last - Parte após a última a ser copiada
+@param sep - Separador colocado entre as partes
+@param len_sep - Quantidade de caracteres do separador
+*/
+static void join_string_copy(char* dest, String* parts[], int first, int last, const char* sep, int len_sep) {
+    int i;
+    for (i = first; i < last; i++) {
+        if (i > 0) {
+            memcpy(dest, sep, len_sep);
+            dest += len_sep;
+        }
+        memcpy(dest, parts[i]->c_str, parts[i]->lenght);
+        dest += parts[i]->lenght;
+    }
+}
+
+/*
+@return - Quantidade de caracteres da junção das partes, ou -1 se "target"
+    for uma das partes
+*/
+static long join_string_lenght(String* target, String* parts[], int size, int len_sep) {
+    long lenght = size > 0 ? (long) (size - 1) * len_sep : 0;
+    int i;
+    for (i = 0; i < size; i++) {
+        if (parts[i] == target)
+            return -1;
+        lenght += parts[i]->lenght;
+    }
+    return lenght;
+}
+
+/*
+Altera uma String dinâmica para receber a junção de várias Strings
+dinâmicas, separadas por um separador (o inverso de "split_string"). O
+espaço necessário é calculado antes, então a String é realocada no máximo
+uma vez
+
+@param target - Instância que irá receber a junção. Se estiver em "parts",
+    nada é feito e 0 é retornado
+@param parts - Array das Strings dinâmicas a serem juntadas
+@param size - Tamanho do array
+@param sep - Separador colocado entre as partes
+@return - 1 se foi executado com sucesso, 0 caso contrário
+*/
+short join_string(String* target, String* parts[], int size, const char* sep) {
+    int len_sep = strlen(sep);
+    long lenght = join_string_lenght(target, parts, size, len_sep);
+
+    if (lenght < 0 || lenght >= INT32_MAX)
+        return 0;
+
+    join_string_reserve(target, (int) lenght);
+    join_string_copy(target->c_str, parts, 0, size, sep, len_sep);
+    return 1;
+}
+
+// parte da junção copiada por uma thread em join_string_parallel
+typedef struct st_join_string_task {
+    char* dest;
+    String** parts;
+    int first;
+    int last;
+    const char* sep;
+    int len_sep;
+} JoinStringTask;
+
+static void* join_string_task(void* arg) {
+    JoinStringTask* task = (JoinStringTask*) arg;
+    join_string_copy(task->dest, task->parts, task->first, task->last, task->sep, task->len_sep);
+    return NULL;
+}
+
+/*
+Igual ao "join_string", mas a cópia das partes é dividida entre "threads"
+threads. Junções menores que JOIN_STRING_PARALLEL_MIN_SIZE bytes são feitas
+na thread atual
+
+@param target - Instância que irá receber a junção. Se estiver em "parts",
+    nada é feito e 0 é retornado
+@param parts - Array das Strings dinâmicas a serem juntadas
+@param size - Tamanho do array
+@param sep - Separador colocado entre as partes
+@param threads - Quantidade máxima de threads
+@return - 1 se foi executado com sucesso, 0 caso contrário
+*/
+short join_string_parallel(String* target, String* parts[], int size, const char* sep, int threads) {
+    int len_sep = strlen(sep);
+    long lenght = join_string_lenght(target, parts, size, len_sep);
+
+    // mais threads que processadores só adiciona trocas de contexto
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    if (cpus > 0 && threads > cpus)
+        threads = (int) cpus;
+    if (threads > size)
+        threads = size;
+
+    if (lenght < 0)
+        return 0;
+
+    if (threads < 2 || lenght < JOIN_STRING_PARALLEL_MIN_SIZE)
+        return join_string(target, parts, size, sep);
+
+    if (lenght >= INT32_MAX)
+        return 0;
+
+    join_string_reserve(target, (int) lenght);
+
+    JoinStringTask tasks[threads];
+    pthread_t ids[threads];
+    short started[threads];
+    long offset = 0;
+    int i, j, first = 0;
+
+    // cada thread copia uma faixa de partes a partir da posição em que a
+    // faixa começa na junção
+    for (i = 0; i < threads; i++) {
+        int last = first + size / threads + (i < size % threads);
+        tasks[i].dest = target->c_str + offset;
+        tasks[i].parts = parts;
+        tasks[i].first = first;
+        tasks[i].last = last;
+        tasks[i].sep = sep;
+        tasks[i].len_sep = len_sep;
+
+        for (j = first; j < last; j++)
+            offset += parts[j]->lenght + (j > 0 ? len_sep : 0);
+        first = last;
+    }
+
+    for (i = 1; i < threads; i++) {
+        started[i] = pthread_create(&ids[i], NULL, join_string_task, &tasks[i]) == 0;
+        if (!started[i])
+            join_string_task(&tasks[i]);
+    }
+    join_string_task(&tasks[0]);
+    for (i = 1; i < threads; i++)
+        if (started[i])
+            pthread_join(ids[i], NULL);
+
+    return 1;
+}
+
+/*
+Igual ao "join_string", mas as partes são os valores (String*) de uma
+lista encadeada
+
+@param target - Instância que irá receber a junção. Se estiver na lista,
+    nada é feito e 0 é retornado
+@param linked_list - Lista cujos valores são Strings dinâmicas
+@param sep - Separador colocado entre as partes
+@return - 1 se foi executado com sucesso, 0 caso contrário
+*/
+short join_linked_list_string(String* target, LinkedList* linked_list, const char* sep) {
+    int len_sep = strlen(sep);
+    long lenght = linked_list->size > 0 ? (long) (linked_list->size - 1) * len_sep : 0;
+    LinkedListElement* it;
+
+    for (it = linked_list->head->next; it != NULL; it = it->next) {
+        if (it->value == target)
+            return 0;
+        lenght += ((String*) it->value)->lenght;
+    }
+
+    if (lenght >= INT32_MAX)
+        return 0;
+
+    join_string_reserve(target, (int) lenght);
+
+    char* dest = target->c_str;
+    for (it = linked_list->head->next; it != NULL; it = it->next) {
+        String* part = (String*) it->value;
+        if (it != linked_list->head->next) {
+            memcpy(dest, sep, len_sep);
+            dest += len_sep;
+        }
+        memcpy(dest, part->c_str, part->lenght);
+        dest += part->lenght;
+    }
+
+    return 1;
+}
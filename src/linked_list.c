@@ -1,7 +1,11 @@
+#define _POSIX_C_SOURCE 200112L
+#include <pthread.h>
+#include <unistd.h>
 #include "linked_list.h"
+#include "alloc_stats.h"
 
-// retorna um novo elemento vazio para lista
-LinkedListElement* new_element () {
+// aloca um elemento vazio, sem registrá-lo nas estatísticas
+static LinkedListElement* element_alloc() {
     LinkedListElement* elemento = (LinkedListElement*) malloc(sizeof(LinkedListElement));
 
     elemento->value = NULL;
@@ -10,10 +14,19 @@ LinkedListElement* new_element () {
     return elemento;
 }
 
-// cria e retorna uma nova lista vazia
+// retorna um novo elemento vazio para lista
+LinkedListElement* new_element () {
+    LinkedListElement* elemento = element_alloc();
+    ALLOC_STATS_RECORD(ALLOC_STATS_NODE_NEW, sizeof(LinkedListElement));
+    return elemento;
+}
+
+// cria e retorna uma nova lista vazia. A cabeça não guarda valor e nenhuma
+// função a remove, então não é contada como elemento nas estatísticas
 LinkedList* new_linked_list() {
     LinkedList* lista = (LinkedList*) malloc(sizeof(LinkedList));
-    lista->head = new_element();
+    lista->head = element_alloc();
+    ALLOC_STATS_RECORD(ALLOC_STATS_ALLOCATION, sizeof(LinkedListElement));
     lista->last = lista->head;
     lista->size = 0;
     return lista;
@@ -54,8 +67,11 @@ void linked_list_eraser_next(LinkedList* linked_list, LinkedListElement* element
         return;
     LinkedListElement* alvo = element->next; // LinkedListElement que eu quero remover
     element->next = alvo->next; // Alvo é excluido da lista
+    if (alvo == linked_list->last)
+        linked_list->last = element;
     free(alvo->value); // Valor do alvo é excluido da memória
     free(alvo); // Alvo é excluido da memária RAM
+    ALLOC_STATS_RECORD(ALLOC_STATS_NODE_FREE, sizeof(LinkedListElement));
     linked_list->size--;
 }
 
@@ -81,8 +97,11 @@ void* linked_list_remove_next(LinkedList* linked_list, LinkedListElement* elemen
         return NULL;
     LinkedListElement* alvo = element->next; // LinkedListElement que eu quero remover
     element->next = alvo->next; // Alvo é excluido da lista
+    if (alvo == linked_list->last)
+        linked_list->last = element;
     void* value = alvo->value;
     free(alvo); // Alvo é excluido da memária RAM
+    ALLOC_STATS_RECORD(ALLOC_STATS_NODE_FREE, sizeof(LinkedListElement));
     linked_list->size--;
     return value;
 }
@@ -147,4 +166,183 @@ void* linked_list_remove_top(LinkedList* linked_list) {
 // Remove e apaga da memória elemento do linked_list_top da lista
 void linked_list_eraser_top(LinkedList* linked_list) {
     linked_list_eraser_next(linked_list, linked_list->head);
-}
\ No newline at end of file
+}
+
+// intercala duas sequências ordenadas de elementos (não vazias), retornando o
+// primeiro elemento. "last" recebe o último elemento de "a" e é atualizado com o
+// último elemento do resultado. Em empates "a" vem primeiro (estável)
+static LinkedListElement* linked_list_merge_elements(LinkedListElement* a, LinkedListElement* b, LinkedListElement* b_last, LinkedListComparator* comparador, LinkedListElement** last) {
+    LinkedListElement head;
+    LinkedListElement* tail = &head;
+
+    while (a != NULL && b != NULL) {
+        if (comparador(a->value, b->value) <= 0) {
+            tail->next = a;
+            a = a->next;
+        } else {
+            tail->next = b;
+            b = b->next;
+        }
+        tail = tail->next;
+    }
+
+    if (a != NULL) {
+        tail->next = a;
+    } else {
+        tail->next = b;
+        *last = b_last;
+    }
+
+    return head.next;
+}
+
+// ordena uma sequência de elementos terminada em NULL. Cada posição k de "runs"
+// guarda uma sequência ordenada de 2^k elementos, que é intercalada com a próxima
+// de mesmo tamanho (merge sort bottom-up em uma única passada pela sequência)
+static LinkedListElement* linked_list_sort_elements(LinkedListElement* first, LinkedListComparator* comparador, LinkedListElement** last) {
+    LinkedListElement* runs[sizeof(int) * 8 + 1] = { NULL };
+    LinkedListElement* lasts[sizeof(int) * 8 + 1];
+    LinkedListElement* run;
+    LinkedListElement* run_last;
+    int k, max = 0;
+
+    *last = NULL;
+    while (first != NULL) {
+        run = first;
+        run_last = first;
+        first = first->next;
+        run->next = NULL;
+
+        for (k = 0; runs[k] != NULL; k++) {
+            LinkedListElement* merged_last = lasts[k];
+            run = linked_list_merge_elements(runs[k], run, run_last, comparador, &merged_last);
+            run_last = merged_last;
+            runs[k] = NULL;
+        }
+
+        runs[k] = run;
+        lasts[k] = run_last;
+        max = k > max ? k : max;
+    }
+
+    run = NULL;
+    for (k = 0; k <= max; k++) {
+        if (runs[k] == NULL)
+            continue;
+
+        if (run == NULL) {
+            run = runs[k];
+            run_last = lasts[k];
+        } else {
+            // o trecho runs[k] contém elementos anteriores aos de run
+            LinkedListElement* merged_last = lasts[k];
+            run = linked_list_merge_elements(runs[k], run, run_last, comparador, &merged_last);
+            run_last = merged_last;
+        }
+    }
+
+    if (run != NULL)
+        *last = run_last;
+    return run;
+}
+
+// ordena a lista (merge sort estável e sem alocação de memória) religando os elementos
+void linked_list_sort(LinkedList* linked_list, LinkedListComparator* comparador) {
+    if (linked_list->size < 2)
+        return;
+
+    LinkedListElement* last;
+    linked_list->head->next = linked_list_sort_elements(linked_list->head->next, comparador, &last);
+    linked_list->last = last;
+}
+
+// move os elementos de "other" para a lista, ambas já ordenadas, mantendo a ordenação.
+// "other" fica vazia, mas continua alocada
+void linked_list_merge(LinkedList* linked_list, LinkedList* other, LinkedListComparator* comparador) {
+    if (linked_list == other || other->size == 0)
+        return;
+
+    if (linked_list->size == 0) {
+        linked_list->head->next = other->head->next;
+        linked_list->last = other->last;
+    } else {
+        LinkedListElement* last = linked_list->last;
+        linked_list->head->next = linked_list_merge_elements(linked_list->head->next, other->head->next, other->last, comparador, &last);
+        linked_list->last = last;
+    }
+    linked_list->size += other->size;
+
+    other->head->next = NULL;
+    other->last = other->head;
+    other->size = 0;
+}
+
+// parte da lista ordenada por uma thread em linked_list_sort_parallel
+typedef struct st_linked_list_sort_task {
+    LinkedListElement* first;
+    LinkedListElement* last;
+    LinkedListComparator* comparador;
+} LinkedListSortTask;
+
+static void* linked_list_sort_task(void* arg) {
+    LinkedListSortTask* task = (LinkedListSortTask*) arg;
+    task->first = linked_list_sort_elements(task->first, task->comparador, &task->last);
+    return NULL;
+}
+
+// ordena a lista dividindo o trabalho entre "threads" threads. Listas pequenas
+// (menores que LINKED_LIST_PARALLEL_MIN_SIZE) são ordenadas na thread atual
+void linked_list_sort_parallel(LinkedList* linked_list, LinkedListComparator* comparador, int threads) {
+    // mais threads que processadores só adiciona trocas de contexto
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    if (cpus > 0 && threads > cpus)
+        threads = (int) cpus;
+    if (threads > linked_list->size / 2)
+        threads = linked_list->size / 2;
+
+    if (threads < 2 || linked_list->size < LINKED_LIST_PARALLEL_MIN_SIZE) {
+        linked_list_sort(linked_list, comparador);
+        return;
+    }
+
+    LinkedListSortTask tasks[threads];
+    pthread_t ids[threads];
+    short started[threads];
+    int i, j;
+
+    // divide a lista em "threads" partes de tamanho parecido
+    LinkedListElement* it = linked_list->head->next;
+    for (i = 0; i < threads; i++) {
+        int size = linked_list->size / threads + (i < linked_list->size % threads);
+        tasks[i].first = it;
+        tasks[i].comparador = comparador;
+        for (j = 1; j < size; j++)
+            it = it->next;
+        LinkedListElement* next = it->next;
+        it->next = NULL;
+        it = next;
+    }
+
+    // a primeira parte é ordenada pela thread atual. Se não for possível criar
+    // uma thread, a parte também é ordenada pela thread atual
+    for (i = 1; i < threads; i++) {
+        started[i] = pthread_create(&ids[i], NULL, linked_list_sort_task, &tasks[i]) == 0;
+        if (!started[i])
+            linked_list_sort_task(&tasks[i]);
+    }
+    linked_list_sort_task(&tasks[0]);
+    for (i = 1; i < threads; i++)
+        if (started[i])
+            pthread_join(ids[i], NULL);
+
+    // intercala as partes ordenadas, duas a duas
+    int step;
+    for (step = 1; step < threads; step *= 2) {
+        for (i = 0; i + step < threads; i += step * 2) {
+            tasks[i].first = linked_list_merge_elements(tasks[i].first, tasks[i + step].first, tasks[i + step].last, comparador, &tasks[i].last);
+        }
+    }
+
+    linked_list->head->next = tasks[0].first;
+    linked_list->last = tasks[0].last;
+}
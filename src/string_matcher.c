@@ -0,0 +1,356 @@
+#include <limits.h>
+#include <stdint.h>
+#include "string_matcher.h"
+
+#ifdef __SSSE3__
+#include <tmmintrin.h>
+#endif
+
+#define MATCHER_HAS_BYTE(matcher, c) ((matcher)->__bytes[(c) >> 3] & (1 << ((c) & 7)))
+
+/*
+Compila o conjunto de bytes usado quando todos os padrões têm 1 byte. Além
+da tabela de 256 bits, cada nibble alto distinto recebe um grupo (até 8;
+acima disso os grupos são compartilhados) usado pela busca com SSSE3: um
+byte é candidato se os grupos do seu nibble baixo e do seu nibble alto se
+cruzam. Candidatos são sempre confirmados na tabela de 256 bits
+
+@param matcher - Conjunto de padrões
+@param patterns - Array dos padrões
+*/
+static void string_matcher_compile_bytes(StringMatcher* matcher, const char* patterns[]) {
+    int groups[16];
+    int size_groups = 0;
+    int i;
+
+    for (i = 0; i < 16; i++)
+        groups[i] = -1;
+
+    for (i = matcher->__size - 1; i >= 0; i--) {
+        unsigned char c = (unsigned char) patterns[i][0];
+        int high = c >> 4;
+
+        // percorre de trás para frente para que, em padrões repetidos, o primeiro prevaleça
+        matcher->__bytes[c >> 3] |= 1 << (c & 7);
+        matcher->__byte_patterns[c] = i;
+
+        if (groups[high] < 0)
+            groups[high] = size_groups++ % 8;
+
+        matcher->__low_nibbles[c & 0x0F] |= 1 << groups[high];
+        matcher->__high_nibbles[high] |= 1 << groups[high];
+    }
+}
+
+/*
+Compila o autômato de Aho-Corasick dos padrões. As transições de falha já
+são resolvidas na tabela de transições, então a busca faz uma única
+consulta por byte. Bytes que não aparecem nos padrões se comportam da
+mesma forma, então a tabela tem uma coluna por byte dos padrões mais uma
+para todos os outros
+
+@param matcher - Conjunto de padrões
+@param patterns - Array dos padrões
+@return - 1 se executado com sucesso, 0 se não houver memória
+*/
+static short string_matcher_compile_automaton(StringMatcher* matcher, const char* patterns[]) {
+    long max_states = 1;
+    int classes = 1;
+    int i, c;
+
+    for (i = 0; i < matcher->__size; i++) {
+        const unsigned char* p = (const unsigned char*) patterns[i];
+        int k;
+        for (k = 0; k < matcher->__lengths[i]; k++)
+            if (matcher->__byte_classes[p[k]] == 0)
+                matcher->__byte_classes[p[k]] = classes++;
+
+        max_states += matcher->__lengths[i];
+        if (max_states > INT_MAX)
+            return 0;
+    }
+
+    // as posições da tabela são int, e o tamanho em bytes precisa caber em size_t
+    if (max_states > INT_MAX / classes || (size_t) (max_states * classes) > SIZE_MAX / sizeof(int))
+        return 0;
+
+    int* transitions = (int*) malloc(sizeof(int) * max_states * classes);
+    int* matches = (int*) malloc(sizeof(int) * max_states);
+    int* fail = (int*) malloc(sizeof(int) * max_states);
+    int* queue = (int*) malloc(sizeof(int) * max_states);
+    int states = 1;
+
+    if (transitions == NULL || matches == NULL || fail == NULL || queue == NULL) {
+        free(transitions);
+        free(matches);
+        free(fail);
+        free(queue);
+        return 0;
+    }
+
+    for (i = 0; i < max_states * classes; i++)
+        transitions[i] = -1;
+    for (i = 0; i < max_states; i++)
+        matches[i] = -1;
+
+    // árvore de prefixos dos padrões
+    for (i = 0; i < matcher->__size; i++) {
+        const unsigned char* p = (const unsigned char*) patterns[i];
+        int state = 0;
+        int k;
+        for (k = 0; k < matcher->__lengths[i]; k++) {
+            int position = state * classes + matcher->__byte_classes[p[k]];
+            if (transitions[position] < 0)
+                transitions[position] = states++;
+            state = transitions[position];
+        }
+        if (matches[state] < 0)
+            matches[state] = i;
+    }
+
+    // busca em largura: a falha de um estado tem profundidade menor, então
+    // já está resolvida quando o estado é visitado
+    int first = 0, last = 0;
+    for (c = 0; c < classes; c++) {
+        int next = transitions[c];
+        if (next < 0) {
+            transitions[c] = 0;
+        } else {
+            fail[next] = 0;
+            queue[last++] = next;
+        }
+    }
+
+    while (first < last) {
+        int state = queue[first++];
+
+        // se o estado não é o fim de um padrão, o maior padrão que termina
+        // nele é o maior que termina na sua falha
+        if (matches[state] < 0)
+            matches[state] = matches[fail[state]];
+
+        for (c = 0; c < classes; c++) {
+            int next = transitions[state * classes + c];
+            if (next < 0) {
+                transitions[state * classes + c] = transitions[fail[state] * classes + c];
+            } else {
+                fail[next] = transitions[fail[state] * classes + c];
+                queue[last++] = next;
+            }
+        }
+    }
+
+    free(fail);
+    free(queue);
+
+    // padrões com prefixos em comum usam menos estados que o máximo
+    int* shrunk_transitions = (int*) realloc(transitions, sizeof(int) * states * classes);
+    int* shrunk_matches = (int*) realloc(matches, sizeof(int) * states);
+
+    matcher->__states = states;
+    matcher->__classes = classes;
+    matcher->__transitions = shrunk_transitions != NULL ? shrunk_transitions : transitions;
+    matcher->__matches = shrunk_matches != NULL ? shrunk_matches : matches;
+    return 1;
+}
+
+/*
+Construtor do conjunto de padrões
+
+@param patterns - Array dos padrões (não podem ser vazios)
+@param size - Tamanho do array
+@return - Nova instância de StringMatcher, ou NULL se não houver padrões,
+    algum padrão for vazio ou não houver memória para o autômato
+*/
+StringMatcher* new_string_matcher(const char* patterns[], int size) {
+    if (size <= 0)
+        return NULL;
+
+    int i;
+    for (i = 0; i < size; i++)
+        if (patterns[i][0] == '\0')
+            return NULL;
+
+    StringMatcher* matcher = (StringMatcher*) calloc(1, sizeof(StringMatcher));
+    if (matcher == NULL)
+        return NULL;
+
+    matcher->__size = size;
+    matcher->__lengths = (int*) malloc(sizeof(int) * size);
+    if (matcher->__lengths == NULL) {
+        free(matcher);
+        return NULL;
+    }
+
+    for (i = 0; i < size; i++) {
+        matcher->__lengths[i] = strlen(patterns[i]);
+        matcher->__max_length = MAX(matcher->__max_length, matcher->__lengths[i]);
+    }
+
+    if (matcher->__max_length == 1) {
+        string_matcher_compile_bytes(matcher, patterns);
+    } else if (!string_matcher_compile_automaton(matcher, patterns)) {
+        free_string_matcher(matcher);
+        return NULL;
+    }
+
+    return matcher;
+}
+
+/*
+Remove o conjunto de padrões da memória
+
+@param matcher - Instância a ser removida
+*/
+void free_string_matcher(StringMatcher* matcher) {
+    free(matcher->__lengths);
+    free(matcher->__transitions);
+    free(matcher->__matches);
+    free(matcher);
+}
+
+/*
+Busca o primeiro byte do conjunto (padrões de 1 byte)
+
+@param matcher - Conjunto de padrões
+@param s - Texto
+@param i - Posição a partir da qual buscar
+@param len - Quantidade de bytes do texto
+@return - Posição do byte, ou -1 se não for encontrado
+*/
+static int find_any_byte(StringMatcher* matcher, const unsigned char* s, int i, int len) {
+#ifdef __SSSE3__
+    __m128i low = _mm_loadu_si128((const __m128i*) matcher->__low_nibbles);
+    __m128i high = _mm_loadu_si128((const __m128i*) matcher->__high_nibbles);
+    __m128i nibble = _mm_set1_epi8(0x0F);
+    __m128i zero = _mm_setzero_si128();
+
+    for (; i + 16 <= len; i += 16) {
+        __m128i chunk = _mm_loadu_si128((const __m128i*) (s + i));
+        __m128i groups_low = _mm_shuffle_epi8(low, _mm_and_si128(chunk, nibble));
+        __m128i groups_high = _mm_shuffle_epi8(high, _mm_and_si128(_mm_srli_epi16(chunk, 4), nibble));
+        __m128i empty = _mm_cmpeq_epi8(_mm_and_si128(groups_low, groups_high), zero);
+        int candidates = ~_mm_movemask_epi8(empty) & 0xFFFF;
+
+        while (candidates != 0) {
+            int k = __builtin_ctz(candidates);
+            if (MATCHER_HAS_BYTE(matcher, s[i + k]))
+                return i + k;
+            candidates &= candidates - 1;
+        }
+    }
+#endif
+
+    for (; i < len; i++)
+        if (MATCHER_HAS_BYTE(matcher, s[i]))
+            return i;
+
+    return -1;
+}
+
+/*
+Busca a primeira ocorrência de qualquer um dos padrões em uma String
+dinâmica. Se mais de um padrão começar na mesma posição, o maior é
+escolhido
+
+@param str - Instância da String dinâmica
+@param matcher - Conjunto de padrões
+@param start - Posição a partir da qual buscar
+@param pattern - Recebe a posição do padrão encontrado no array informado
+    em new_string_matcher (pode ser NULL)
+@return - Posição da ocorrência, ou -1 se nenhum padrão for encontrado
+*/
+int find_any(String* str, StringMatcher* matcher, int start, int* pattern) {
+    const unsigned char* s = (const unsigned char*) str->c_str;
+    int best_start = -1;
+    int best = -1;
+    int state = 0;
+    int i;
+
+    if (start < 0 || start > str->lenght)
+        return -1;
+
+    if (matcher->__states == 0) {
+        best_start = find_any_byte(matcher, s, start, str->lenght);
+        if (best_start >= 0 && pattern != NULL)
+            *pattern = matcher->__byte_patterns[s[best_start]];
+        return best_start;
+    }
+
+    const int* transitions = matcher->__transitions;
+    const unsigned char* byte_classes = matcher->__byte_classes;
+    int classes = matcher->__classes;
+
+    for (i = start; i < str->lenght; i++) {
+        state = transitions[state * classes + byte_classes[s[i]]];
+
+        // o maior padrão que termina em "i" é o que começa mais à esquerda;
+        // em empates, o que termina depois é o maior
+        int found = matcher->__matches[state];
+        if (found >= 0 && (best_start < 0 || i - matcher->__lengths[found] + 1 <= best_start)) {
+            best_start = i - matcher->__lengths[found] + 1;
+            best = found;
+        }
+
+        // nenhum padrão que termine depois de "i + 1" pode começar antes de best_start
+        if (best_start >= 0 && i + 2 - best_start > matcher->__max_length)
+            break;
+    }
+
+    if (best_start >= 0 && pattern != NULL)
+        *pattern = best;
+    return best_start;
+}
+
+/*
+Retorna o tamanho do array necessário para armazenar o resultado do
+método "split_string_any"
+
+@param str - Instância da String dinâmica que será separada
+@param matcher - Conjunto de separadores
+@return - Tamanho do array que armazenará o resultado do split
+*/
+int size_split_string_any(String* str, StringMatcher* matcher) {
+    if (str->lenght == 0)
+        return 0;
+
+    int size = 1;
+    int position = 0;
+    int pattern;
+    int found;
+
+    while ((found = find_any(str, matcher, position, &pattern)) >= 0) {
+        size++;
+        position = found + matcher->__lengths[pattern];
+    }
+
+    return size;
+}
+
+/*
+Igual ao "split_string", mas qualquer um dos padrões do conjunto é um
+separador
+
+@param str - Instância da String dinâmica que será separada
+@param target - Array que armazenará o resultado do split. O array deve
+    estar completamente desalocado da memória
+@param matcher - Conjunto de separadores
+@return - 1 se foi executado com sucesso, 0 caso contrário
+*/
+short split_string_any(String* str, String* target[], StringMatcher* matcher) {
+    if (str->lenght == 0)
+        return 1;
+
+    int i_target = 0;
+    int position = 0;
+    int pattern;
+    int found;
+
+    while ((found = find_any(str, matcher, position, &pattern)) >= 0) {
+        target[i_target++] = new_string_chars(str->c_str + position, found - position);
+        position = found + matcher->__lengths[pattern];
+    }
+
+    target[i_target] = new_string_chars(str->c_str + position, str->lenght - position);
+    return 1;
+}
@@ -1,5 +1,7 @@
 #include <stdio.h>
+#include <locale.h>
 #include "dynamic_string.h"
+#include "linked_list.h"
 
 int main (int argc, const char* argv[]) {
 
@@ -115,5 +117,121 @@ int main (int argc, const char* argv[]) {
 
     free_string(str);
 
+    str = new_string("Hello!");
+    String* clone = clone_string(str);
+
+    printf("%s / %s / %d\n", str->c_str, clone->c_str, str->c_str == clone->c_str);
+
+    cat_string(clone, " World!");
+
+    printf("%s / %s / %d\n", str->c_str, clone->c_str, str->c_str == clone->c_str);
+
+    free_string(clone);
+    clone = clone_string(str);
+
+    printf("%d\n", detach_string(clone));
+    printf("%d\n", detach_string(clone));
+
+    free_string(clone);
+    clone = clone_string(str);
+    set_string_chars(clone, "World!!!", 5);
+
+    printf("%s / %s / %d\n", str->c_str, clone->c_str, clone->lenght);
+
+    free_string(str);
+    free_string(clone);
+
+    str = new_string_reallocate_strategy("", 0, STRICT_STRATEGY_REALLOCATED);
+    cat_format(str, "%s=%d;", "count", 42);
+    cat_format(str, "%-30s|", "format sem espaço livre");
+    cat_int64(str, INT64_MIN);
+    cat_string(str, " ");
+    cat_uint64(str, UINT64_MAX);
+    cat_string(str, " ");
+    cat_hex64(str, 0xdeadbeef);
+
+    printf("%s / %d / %d\n", str->c_str, str->lenght, (int) strlen(str->c_str));
+
+    set_string(str, "");
+    double doubles[] = { 0, -0.0, 3, 0.1, -12.375, 1e-5, 1.0 / 3, 1e300, 123456789012345678.0, 5e-324, 2.5e-310 };
+    for (i = 0; i < 11; i++) {
+        cat_double(str, doubles[i]);
+        cat_string(str, " ");
+    }
+
+    printf("%s\n", str->c_str);
+
+    // o separador decimal não depende do locale (se algum com ',' existir)
+    const char* locales[] = { "pt_BR.UTF-8", "de_DE.UTF-8", "fr_FR.UTF-8", "pt_BR", "de_DE" };
+    for (i = 0; i < 5; i++)
+        if (setlocale(LC_NUMERIC, locales[i]) != NULL)
+            break;
+
+    set_string(str, "");
+    cat_double(str, 0.1);
+    cat_string(str, " ");
+    cat_double(str, 1.0 / 3);
+    cat_string(str, " ");
+    cat_double(str, -1e-300);
+
+    printf("'%s' %s\n", localeconv()->decimal_point, str->c_str);
+    setlocale(LC_NUMERIC, "C");
+
+    free_string(str);
+
+    String* parts[] = { new_string("a"), new_string(""), new_string("bc"), new_string("def") };
+    str = new_string("valor antigo");
+
+    join_string(str, parts, 4, ", ");
+
+    printf("%s / %d / %d\n", str->c_str, str->lenght, get_length_allocated_string(str));
+
+    join_string(str, parts, 0, ", ");
+
+    printf("'%s' / %d\n", str->c_str, str->lenght);
+
+    LinkedList* linked_list = new_linked_list();
+    for (i = 0; i < 4; i++)
+        linked_list_add(linked_list, parts[i]);
+
+    join_linked_list_string(str, linked_list, "");
+
+    printf("%s / %d\n", str->c_str, str->lenght);
+
+    // a String que recebe a junção não pode ser uma das partes
+    String* self[] = { str, parts[2] };
+    printf("%d ", join_string(str, self, 2, ","));
+    printf("%d ", join_string_parallel(str, self, 2, ",", 2));
+    linked_list_add(linked_list, str);
+    printf("%d / %s\n", join_linked_list_string(str, linked_list, ""), str->c_str);
+    linked_list_remove_at(linked_list, 4);
+
+    // grande o suficiente para usar threads (se houver mais de um processador)
+    int size_big = 1000;
+    String* big[size_big];
+    for (i = 0; i < size_big; i++) {
+        big[i] = new_string("");
+        set_min__length_allocated(big[i], 5001);
+        memset(big[i]->c_str, 'a' + i % 26, 5000);
+        big[i]->c_str[5000] = '\0';
+        big[i]->lenght = 5000;
+    }
+
+    join_string_parallel(str, big, size_big, ";", 4);
+
+    String* check = new_string("");
+    join_string(check, big, size_big, ";");
+
+    printf("%d / %d\n", str->lenght, strcmp(str->c_str, check->c_str));
+
+    for (i = 0; i < size_big; i++)
+        free_string(big[i]);
+    while (linked_list->size > 0)
+        free_string((String*) linked_list_remove_top(linked_list));
+    free(linked_list->head);
+    free(linked_list);
+    free_string(check);
+    free_string(str);
+
     return 0;
 }
\ No newline at end of file
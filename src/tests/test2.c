@@ -0,0 +1,72 @@
+#include <stdio.h>
+#include "linked_list.h"
+
+int compare_int(void* a, void* b) {
+    return *(int*) a - *(int*) b;
+}
+
+void print_linked_list(LinkedList* linked_list) {
+    for (LinkedListElement* it = linked_list->head->next; it != NULL; it = it->next)
+        printf("%d ", *(int*) it->value);
+    printf("/ size = %d / last = %d\n", linked_list->size, *(int*) linked_list->last->value);
+}
+
+int main (int argc, const char* argv[]) {
+
+    int values[] = { 5, 3, 9, 1, 3, 7, 2, 8, 0, 6 };
+    int others[] = { 1, 4, 4, 10 };
+    int i;
+
+    LinkedList* linked_list = new_linked_list();
+    for (i = 0; i < 10; i++)
+        linked_list_add(linked_list, &values[i]);
+
+    linked_list_sort(linked_list, compare_int);
+    print_linked_list(linked_list);
+
+    // estabilidade: o primeiro 3 adicionado deve continuar antes do segundo
+    printf("%d\n", linked_list_find_by_index(linked_list, 3)->value == &values[1]);
+
+    linked_list_add(linked_list, &others[3]);
+    print_linked_list(linked_list);
+
+    LinkedList* other = new_linked_list();
+    for (i = 0; i < 4; i++)
+        linked_list_add(other, &others[i]);
+
+    linked_list_merge(linked_list, other, compare_int);
+    print_linked_list(linked_list);
+    printf("%d\n", other->size);
+
+    linked_list_merge(other, linked_list, compare_int);
+    print_linked_list(other);
+    printf("%d\n", linked_list->size);
+
+    int count = 200000;
+    int* many = (int*) malloc(sizeof(int) * count);
+    for (i = 0; i < count; i++) {
+        many[i] = (i * 7919) % count;
+        linked_list_add(linked_list, &many[i]);
+    }
+
+    linked_list_sort_parallel(linked_list, compare_int, 4);
+
+    int sorted = 1;
+    i = 0;
+    for (LinkedListElement* it = linked_list->head->next; it != NULL; it = it->next)
+        sorted = sorted && *(int*) it->value == i++;
+    printf("sorted = %d / size = %d / last = %d\n", sorted, linked_list->size, *(int*) linked_list->last->value);
+
+    while (linked_list->size > 0)
+        linked_list_remove_top(linked_list);
+    while (other->size > 0)
+        linked_list_remove_top(other);
+
+    free(linked_list->head);
+    free(linked_list);
+    free(other->head);
+    free(other);
+    free(many);
+
+    return 0;
+}
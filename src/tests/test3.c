@@ -0,0 +1,52 @@
+#include <stdio.h>
+#include <inttypes.h>
+#include "string_number.h"
+
+int main (int argc, const char* argv[]) {
+
+    const char* ints[] = {
+        "0", "-0", "+42", "-9223372036854775808", "9223372036854775807",
+        "9223372036854775808", "000000000000000000000000012345678",
+        "18446744073709551615", "18446744073709551616", "12a", "-", ""
+    };
+    int i;
+
+    for (i = 0; i < 12; i++) {
+        int64_t value = 0;
+        uint64_t uvalue = 0;
+        int len = strlen(ints[i]);
+        int result = chars_to_int64(ints[i], len, &value);
+        int uresult = chars_to_uint64(ints[i], len, &uvalue);
+        printf("'%s' => %d %" PRId64 " / %d %" PRIu64 "\n", ints[i], result, value, uresult, uvalue);
+    }
+
+    const char* doubles[] = {
+        "0", "-0.0", "3.14159", ".5", "5.", "1e10", "-2.5E-3", "1.5e25",
+        "123456789012345678901234567890", "0.1000000000000000055511151231257827",
+        "1e400", "1e-400", "inf", "-NaN", "1e", "1.2.3", ".",
+        "0.30000000000000004", "1.2345678901234568e+17", "5e-324", "2.2250738585072011e-308",
+        "1.7976931348623157e308", "9007199254740993", "-4.9406564584124654e-324"
+    };
+
+    for (i = 0; i < 24; i++) {
+        double value = 0;
+        int result = chars_to_double(doubles[i], strlen(doubles[i]), &value);
+        printf("'%s' => %d %.17g\n", doubles[i], result, value);
+    }
+
+    String* str = new_string("10;-20;30;40x;50");
+    int size = size_split_string(str, ";");
+    String* fields[size];
+    int64_t values[size];
+    int index_error = -1;
+    split_string(str, fields, ";");
+
+    int result = strings_to_int64(fields, size, values, &index_error);
+    printf("%d / %d / %" PRId64 " %" PRId64 " %" PRId64 "\n", result, index_error, values[0], values[1], values[2]);
+
+    for (i = 0; i < size; i++)
+        free_string(fields[i]);
+    free_string(str);
+
+    return 0;
+}
@@ -0,0 +1,64 @@
+#include <stdio.h>
+#include "utf8_string.h"
+
+int main (int argc, const char* argv[]) {
+
+    const char* texts[] = {
+        "Meu Feijão com Arroz", "ação € 𝄞 ok", "\xC3", "\xC0\xAF", "\xED\xA0\x80",
+        "\xF4\x90\x80\x80", "abcdefghijklmnopqrstuvwxyz \xE2\x82",
+        // caracteres atravessando o limite de um bloco de 16 bytes
+        "0123456789abcde\xE2\x82\xAC 0123456789abcdef\xF0\x9D\x84\x9E",
+        "0123456789abcdefghij\xED\xA0\x80 0123456789abcdef",
+        "0123456789abcde\xE2\x82 0123456789abcdef"
+    };
+    int i;
+
+    for (i = 0; i < 10; i++) {
+        int len = strlen(texts[i]);
+        printf("%d %d %d\n", utf8_valid(texts[i], len), len, utf8_length(texts[i], len));
+    }
+
+    String* str = new_string("Meu Feijão com Arroz");
+    String* sub = new_string("");
+
+    utf8_sub_string(str, sub, 4, 10, NULL);
+    printf("%s / %d\n", sub->c_str, sub->lenght);
+
+    // String com mais caracteres que UTF8_INDEX_STEP para usar o índice
+    set_string(str, "");
+    for (i = 0; i < 50; i++)
+        cat_string(str, "ãé");
+    cat_string(str, "fim");
+
+    Utf8Index* index = new_utf8_index(str);
+    printf("%d / %d / %d\n", index->lenght, index->size, utf8_offset_string(str, 100, index));
+
+    printf("%d ", utf8_sub_string(str, sub, 98, 103, index));
+    printf("%s\n", sub->c_str);
+    printf("%d %d\n", utf8_sub_string(str, sub, 98, 104, index), utf8_sub_string(str, sub, 98, 103, NULL));
+    free_utf8_index(index);
+
+    set_string(str, "ação;€;;𝄞");
+    int size = utf8_size_split_string(str, ";");
+    String* parts[size];
+    utf8_split_string(str, parts, ";");
+    for (i = 0; i < size; i++) {
+        printf("'%s' ", parts[i]->c_str);
+        free_string(parts[i]);
+    }
+    printf("/ %d\n", size);
+
+    size = utf8_size_split_string(str, "");
+    String* chars[size];
+    utf8_split_string(str, chars, "");
+    for (i = 0; i < size; i++) {
+        printf("%s ", chars[i]->c_str);
+        free_string(chars[i]);
+    }
+    printf("/ %d\n", size);
+
+    free_string(sub);
+    free_string(str);
+
+    return 0;
+}
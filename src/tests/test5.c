@@ -0,0 +1,84 @@
+#include <stdio.h>
+#include <pthread.h>
+#include "alloc_stats.h"
+#include "dynamic_string.h"
+#include "linked_list.h"
+
+// conta os crescimentos de buffer observados pelo hook
+void count_growths(AllocStatsEvent event, long bytes, void* user) {
+    if (event == ALLOC_STATS_GROWTH)
+        (*(int*) user)++;
+}
+
+// registra uma alocação em uma thread que termina logo em seguida
+void* new_string_task(void* arg) {
+    free_string(new_string("thread"));
+    return NULL;
+}
+
+int main (int argc, const char* argv[]) {
+
+    AllocStats stats;
+    int growths = 0;
+    int i;
+
+    alloc_stats_set_hook(count_growths, &growths);
+
+    String* str = new_string_reallocate_strategy("", 0, DOUBLE_STRATEGY_REALLOCATED);
+    for (i = 0; i < 100; i++)
+        cat_string(str, "0123456789");
+
+    String* clone = clone_string(str);
+    cat_string(clone, "!");
+
+    LinkedList* linked_list = new_linked_list();
+    for (i = 0; i < 10; i++)
+        linked_list_add(linked_list, str);
+    linked_list_remove_top(linked_list);
+
+    alloc_stats_get_thread(&stats);
+    printf("%ld %ld %ld / %d\n", stats.growths[ALLOC_STATS_DOUBLE], stats.growths[ALLOC_STATS_HALF], stats.live_nodes, growths);
+
+    // sem CEMDUTIL_STATS nada é registrado; com ele o hook vê cada crescimento
+    // e a lista tem 9 elementos (a cabeça não é contada)
+    short expected = alloc_stats_enabled()
+        ? growths > 0 && stats.growths[ALLOC_STATS_DOUBLE] == growths && stats.live_nodes == 9
+        : growths == 0 && stats.allocations == 0 && stats.live_nodes == 0;
+    // a junção em uma String que compartilha o buffer aloca um único buffer
+    String* parts[] = { str, str };
+    String* shared = clone_string(str);
+    long allocations = stats.allocations + stats.reallocations;
+    join_string(shared, parts, 2, ",");
+    alloc_stats_get_thread(&stats);
+    printf("%ld / %d\n", stats.allocations + stats.reallocations - allocations, shared->lenght);
+    expected = expected && stats.allocations + stats.reallocations - allocations == alloc_stats_enabled();
+
+    // os contadores de threads finalizadas continuam somados
+    pthread_t thread;
+    alloc_stats_get(&stats);
+    allocations = stats.allocations;
+    for (i = 0; i < 8; i++) {
+        pthread_create(&thread, NULL, new_string_task, NULL);
+        pthread_join(thread, NULL);
+    }
+    alloc_stats_get(&stats);
+    printf("%ld\n", stats.allocations - allocations);
+    expected = expected && stats.allocations - allocations == 8 * alloc_stats_enabled();
+
+    printf("stats %s: %s\n", alloc_stats_enabled() ? "enabled" : "disabled", expected ? "ok" : "erro");
+
+    free_string(shared);
+    while (linked_list->size > 0)
+        linked_list_remove_top(linked_list);
+    free(linked_list->head);
+    free(linked_list);
+    free_string(clone);
+    free_string(str);
+    alloc_stats_dump(stdout);
+
+    alloc_stats_reset();
+    alloc_stats_get(&stats);
+    printf("%ld %ld\n", stats.allocations, stats.live_nodes);
+
+    return expected ? 0 : 1;
+}
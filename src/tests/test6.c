@@ -0,0 +1,51 @@
+#include <stdio.h>
+#include "string_matcher.h"
+
+void print_split(String* str, StringMatcher* matcher) {
+    int size = size_split_string_any(str, matcher);
+    String* parts[size];
+    int i;
+
+    split_string_any(str, parts, matcher);
+    for (i = 0; i < size; i++) {
+        printf("'%s' ", parts[i]->c_str);
+        free_string(parts[i]);
+    }
+    printf("/ %d\n", size);
+}
+
+int main (int argc, const char* argv[]) {
+
+    const char* bytes[] = { ",", ";", "\t", "|", "!" };
+    const char* words[] = { "he", "she", "his", "hers", "::", "abcd", "bc" };
+    int pattern = -1;
+
+    StringMatcher* separators = new_string_matcher(bytes, 5);
+    StringMatcher* keywords = new_string_matcher(words, 7);
+
+    String* str = new_string("a,b;;c\td|e,Feijão com arroz e feijão,fim");
+    print_split(str, separators);
+    printf("%d ", find_any(str, separators, 12, &pattern));
+    printf("%d\n", pattern);
+
+    set_string(str, "ushers::abcd-bcd");
+    printf("%d ", find_any(str, keywords, 0, &pattern));
+    printf("%d / ", pattern);
+    printf("%d ", find_any(str, keywords, 4, &pattern));
+    printf("%d / ", pattern);
+    printf("%d ", find_any(str, keywords, 8, &pattern));
+    printf("%d / ", pattern);
+    printf("%d ", find_any(str, keywords, 12, &pattern));
+    printf("%d / ", pattern);
+    printf("%d\n", find_any(str, keywords, 15, &pattern));
+    print_split(str, keywords);
+
+    const char* empty[] = { "a", "" };
+    printf("%d\n", new_string_matcher(empty, 2) == NULL);
+
+    free_string(str);
+    free_string_matcher(separators);
+    free_string_matcher(keywords);
+
+    return 0;
+}
@@ -0,0 +1,437 @@
+#include <stdint.h>
+#include "utf8_string.h"
+
+#ifdef __SSSE3__
+#include <tmmintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#define UTF8_HIGH_BITS 0x8080808080808080ULL
+
+/*
+@param c - Primeiro byte de um caractere em UTF-8
+@return - Quantidade de bytes do caractere
+*/
+static int utf8_char_size(unsigned char c) {
+    if (c < 0x80)
+        return 1;
+    if (c < 0xE0)
+        return 2;
+    if (c < 0xF0)
+        return 3;
+    return 4;
+}
+
+/*
+Avança uma quantidade de caracteres em um texto em UTF-8 válido
+
+@param s - Texto em UTF-8
+@param len - Quantidade de bytes do texto
+@param offset - Posição em bytes de onde começar
+@param count - Quantidade de caracteres a avançar
+@return - Posição em bytes após os caracteres, ou -1 se o texto acabar antes
+*/
+static int utf8_skip(const char* s, int len, int offset, int count) {
+    while (count > 0 && offset < len) {
+        offset += utf8_char_size((unsigned char) s[offset]);
+        count--;
+    }
+
+    return count == 0 ? MIN(offset, len) : -1;
+}
+
+/*
+@param s - Texto
+@param len - Quantidade de bytes do texto
+@param i - Posição inicial
+@return - Posição do primeiro byte não ASCII a partir de "i" (ou "len")
+*/
+static int utf8_skip_ascii(const unsigned char* s, int len, int i) {
+#ifdef __SSE2__
+    while (i + 16 <= len) {
+        __m128i chunk = _mm_loadu_si128((const __m128i*) (s + i));
+        if (_mm_movemask_epi8(chunk) != 0)
+            break;
+        i += 16;
+    }
+#endif
+
+    while (i + 8 <= len) {
+        uint64_t chunk;
+        memcpy(&chunk, s + i, sizeof(chunk));
+        if ((chunk & UTF8_HIGH_BITS) != 0)
+            break;
+        i += 8;
+    }
+
+    while (i < len && s[i] < 0x80)
+        i++;
+
+    return i;
+}
+
+/*
+Verifica as sequências de um texto a partir de uma posição, um caractere
+por vez (trechos ASCII são pulados 16 bytes por vez)
+
+@param p - Texto a ser verificado
+@param len - Quantidade de bytes do texto
+@param i - Posição do início de um caractere
+@return - 1 se o texto a partir de "i" é UTF-8 válido, 0 caso contrário
+*/
+static short utf8_valid_from(const unsigned char* p, int len, int i) {
+    while ((i = utf8_skip_ascii(p, len, i)) < len) {
+        unsigned char c = p[i];
+        unsigned char min = 0x80; // faixa permitida para o segundo byte
+        unsigned char max = 0xBF;
+        int size;
+
+        if (c >= 0xC2 && c <= 0xDF) {
+            size = 2;
+        } else if (c >= 0xE0 && c <= 0xEF) {
+            size = 3;
+            if (c == 0xE0)
+                min = 0xA0; // overlong
+            else if (c == 0xED)
+                max = 0x9F; // surrogates
+        } else if (c >= 0xF0 && c <= 0xF4) {
+            size = 4;
+            if (c == 0xF0)
+                min = 0x90; // overlong
+            else if (c == 0xF4)
+                max = 0x8F; // acima de U+10FFFF
+        } else {
+            return 0;
+        }
+
+        if (len - i < size || p[i + 1] < min || p[i + 1] > max)
+            return 0;
+
+        int k;
+        for (k = 2; k < size; k++)
+            if ((p[i + k] & 0xC0) != 0x80)
+                return 0;
+
+        i += size;
+    }
+
+    return 1;
+}
+
+#ifdef __SSSE3__
+// erros detectados pelas tabelas (Keiser e Lemire, "Validating UTF-8 In
+// Less Than One Instruction Per Byte"), pelo par byte anterior / byte atual
+#define UTF8_TOO_SHORT (1 << 0) // 11______ seguido de 0_______ ou 11______
+#define UTF8_TOO_LONG (1 << 1) // 0_______ seguido de 10______
+#define UTF8_OVERLONG_3 (1 << 2) // 11100000 100_____
+#define UTF8_TOO_LARGE (1 << 3) // 11110100 1001____, 11110100 101_____ e 11110101+ 10______
+#define UTF8_SURROGATE (1 << 4) // 11101101 101_____
+#define UTF8_OVERLONG_2 (1 << 5) // 1100000_ 10______
+#define UTF8_TOO_LARGE_1000 (1 << 6) // 11110101+ 1000____
+#define UTF8_OVERLONG_4 (1 << 6) // 11110000 1000____
+#define UTF8_TWO_CONTS (1 << 7) // 10______ 10______
+#define UTF8_CARRY (UTF8_TOO_SHORT | UTF8_TOO_LONG | UTF8_TWO_CONTS)
+
+/*
+Verifica um bloco de 16 bytes. Cada byte é classificado pelos nibbles do
+byte anterior e pelo seu nibble alto (3 consultas com pshufb); o resultado
+é um conjunto de erros que só é vazio se o par é válido. Bytes de
+continuação que são o terceiro ou quarto byte de um caractere são os únicos
+em que UTF8_TWO_CONTS é esperado
+
+@param input - Bloco a ser verificado
+@param previous - Bloco anterior (zeros no primeiro bloco)
+@return - Bytes diferentes de zero onde há erro
+*/
+static __m128i utf8_check_block(__m128i input, __m128i previous) {
+    const __m128i byte_1_high_table = _mm_setr_epi8(
+        // 0_______ (ASCII)
+        UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG,
+        UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG,
+        // 10______ (continuação)
+        (char) UTF8_TWO_CONTS, (char) UTF8_TWO_CONTS, (char) UTF8_TWO_CONTS, (char) UTF8_TWO_CONTS,
+        // 1100____, 1101____, 1110____, 1111____ (início de 2, 2, 3 e 4 bytes)
+        UTF8_TOO_SHORT | UTF8_OVERLONG_2,
+        UTF8_TOO_SHORT,
+        UTF8_TOO_SHORT | UTF8_OVERLONG_3 | UTF8_SURROGATE,
+        UTF8_TOO_SHORT | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000 | UTF8_OVERLONG_4);
+    const __m128i byte_1_low_table = _mm_setr_epi8(
+        (char) (UTF8_CARRY | UTF8_OVERLONG_3 | UTF8_OVERLONG_2 | UTF8_OVERLONG_4), // ____0000
+        (char) (UTF8_CARRY | UTF8_OVERLONG_2), // ____0001
+        (char) UTF8_CARRY,
+        (char) UTF8_CARRY,
+        (char) (UTF8_CARRY | UTF8_TOO_LARGE), // ____0100
+        (char) (UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000),
+        (char) (UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000),
+        (char) (UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000),
+        (char) (UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000),
+        (char) (UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000),
+        (char) (UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000),
+        (char) (UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000),
+        (char) (UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000),
+        (char) (UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000 | UTF8_SURROGATE), // ____1101
+        (char) (UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000),
+        (char) (UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000));
+    const __m128i byte_2_high_table = _mm_setr_epi8(
+        // 0_______ (ASCII)
+        UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT,
+        UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT,
+        // 1000____, 1001____, 101_____ (continuação)
+        (char) (UTF8_TOO_LONG | UTF8_OVERLONG_2 | UTF8_TWO_CONTS | UTF8_OVERLONG_3 | UTF8_TOO_LARGE_1000 | UTF8_OVERLONG_4),
+        (char) (UTF8_TOO_LONG | UTF8_OVERLONG_2 | UTF8_TWO_CONTS | UTF8_OVERLONG_3 | UTF8_TOO_LARGE),
+        (char) (UTF8_TOO_LONG | UTF8_OVERLONG_2 | UTF8_TWO_CONTS | UTF8_SURROGATE | UTF8_TOO_LARGE),
+        (char) (UTF8_TOO_LONG | UTF8_OVERLONG_2 | UTF8_TWO_CONTS | UTF8_SURROGATE | UTF8_TOO_LARGE),
+        // 11______ (início de caractere)
+        UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT);
+    const __m128i nibble = _mm_set1_epi8(0x0F);
+
+    __m128i prev1 = _mm_alignr_epi8(input, previous, 15);
+    __m128i prev2 = _mm_alignr_epi8(input, previous, 14);
+    __m128i prev3 = _mm_alignr_epi8(input, previous, 13);
+
+    __m128i byte_1_high = _mm_shuffle_epi8(byte_1_high_table, _mm_and_si128(_mm_srli_epi16(prev1, 4), nibble));
+    __m128i byte_1_low = _mm_shuffle_epi8(byte_1_low_table, _mm_and_si128(prev1, nibble));
+    __m128i byte_2_high = _mm_shuffle_epi8(byte_2_high_table, _mm_and_si128(_mm_srli_epi16(input, 4), nibble));
+    __m128i special = _mm_and_si128(_mm_and_si128(byte_1_high, byte_1_low), byte_2_high);
+
+    // o bit alto fica ligado se dois bytes antes há um início de 3 ou 4
+    // bytes, ou três bytes antes há um início de 4 bytes
+    __m128i third = _mm_subs_epu8(prev2, _mm_set1_epi8(0xE0 - 0x80));
+    __m128i fourth = _mm_subs_epu8(prev3, _mm_set1_epi8(0xF0 - 0x80));
+    __m128i must_be_continuation = _mm_and_si128(_mm_or_si128(third, fourth), _mm_set1_epi8((char) 0x80));
+
+    return _mm_xor_si128(must_be_continuation, special);
+}
+#endif
+
+/*
+Verifica se um texto é UTF-8 válido (sem sequências incompletas, overlong,
+surrogates ou acima de U+10FFFF). Com SSSE3 os blocos de 16 bytes são
+verificados pelas tabelas de Keiser e Lemire, sem desvios por caractere, e
+apenas o final do texto passa pela verificação de um caractere por vez
+
+@param s - Texto a ser verificado
+@param len - Quantidade de bytes do texto
+@return - 1 se o texto é UTF-8 válido, 0 caso contrário
+*/
+short utf8_valid(const char* s, int len) {
+    const unsigned char* p = (const unsigned char*) s;
+    int i = 0;
+
+#ifdef __SSSE3__
+    __m128i previous = _mm_setzero_si128();
+    __m128i error = _mm_setzero_si128();
+
+    for (; i + 16 <= len; i += 16) {
+        __m128i input = _mm_loadu_si128((const __m128i*) (p + i));
+
+        // blocos ASCII após blocos ASCII não têm o que verificar
+        if (_mm_movemask_epi8(_mm_or_si128(input, previous)) != 0)
+            error = _mm_or_si128(error, utf8_check_block(input, previous));
+        previous = input;
+    }
+
+    if (_mm_movemask_epi8(_mm_cmpeq_epi8(error, _mm_setzero_si128())) != 0xFFFF)
+        return 0;
+
+    // o caractere que atravessa o fim do último bloco é verificado de novo
+    // desde o início
+    int k;
+    for (k = i - 1; k >= 0 && k >= i - 3; k--) {
+        if ((p[k] & 0xC0) != 0x80) {
+            if (p[k] >= 0xC0 && utf8_char_size(p[k]) > i - k)
+                i = k;
+            break;
+        }
+    }
+#endif
+
+    return utf8_valid_from(p, len, i);
+}
+
+/*
+Conta a quantidade de caracteres (code points) de um texto em UTF-8 válido
+
+@param s - Texto em UTF-8
+@param len - Quantidade de bytes do texto
+@return - Quantidade de caracteres
+*/
+int utf8_length(const char* s, int len) {
+    int continuations = 0;
+    int i = 0;
+
+    // bytes de continuação (10xxxxxx) não iniciam um caractere
+    for (; i + 8 <= len; i += 8) {
+        uint64_t chunk;
+        memcpy(&chunk, s + i, sizeof(chunk));
+        continuations += __builtin_popcountll(chunk & ~(chunk << 1) & UTF8_HIGH_BITS);
+    }
+
+    for (; i < len; i++)
+        continuations += (s[i] & 0xC0) == 0x80;
+
+    return len - continuations;
+}
+
+/*
+@param str - Instância da String dinâmica
+@return - 1 se a String dinâmica é UTF-8 válido, 0 caso contrário
+*/
+short utf8_valid_string(String* str) {
+    return utf8_valid(str->c_str, str->lenght);
+}
+
+/*
+@param str - Instância da String dinâmica em UTF-8 válido
+@return - Quantidade de caracteres (code points) da String dinâmica
+*/
+int utf8_length_string(String* str) {
+    return utf8_length(str->c_str, str->lenght);
+}
+
+/*
+Cria o índice das posições dos caracteres de uma String dinâmica
+
+@param str - Instância da String dinâmica em UTF-8 válido
+@return - Novo índice
+*/
+Utf8Index* new_utf8_index(String* str) {
+    Utf8Index* index = (Utf8Index*) malloc(sizeof(Utf8Index));
+    index->lenght = utf8_length_string(str);
+    index->size = index->lenght / UTF8_INDEX_STEP + 1;
+    index->offsets = (int*) malloc(sizeof(int) * index->size);
+
+    int offset = 0;
+    int i;
+    for (i = 0; i < index->size; i++) {
+        index->offsets[i] = offset;
+        offset = utf8_skip(str->c_str, str->lenght, offset, UTF8_INDEX_STEP);
+    }
+
+    return index;
+}
+
+/*
+Remove o índice da memória
+
+@param index - Índice a ser removido
+*/
+void free_utf8_index(Utf8Index* index) {
+    free(index->offsets);
+    free(index);
+}
+
+/*
+Retorna a posição em bytes de um caractere de uma String dinâmica
+
+@param str - Instância da String dinâmica em UTF-8 válido
+@param position - Posição do caractere (code point). Pode ser igual à
+    quantidade de caracteres (retorna str->lenght)
+@param index - Índice criado para "str" por new_utf8_index (pode ser NULL)
+@return - Posição em bytes, ou -1 se "position" estiver fora da String
+*/
+int utf8_offset_string(String* str, int position, Utf8Index* index) {
+    if (position < 0)
+        return -1;
+
+    if (index == NULL)
+        return utf8_skip(str->c_str, str->lenght, 0, position);
+
+    if (position > index->lenght)
+        return -1;
+
+    int offset = index->offsets[position / UTF8_INDEX_STEP];
+    return utf8_skip(str->c_str, str->lenght, offset, position % UTF8_INDEX_STEP);
+}
+
+/*
+Altera uma String dinâmica para receber uma substring de outra String
+dinâmica em UTF-8, com posições contadas em caracteres (code points)
+
+@param str - Instância da String dinâmica em UTF-8 válido
+@param target - Instância que irá receber a substring. Não pode ser a
+    mesma instância de str
+@param start - Posição inicial da substring (em caracteres)
+@param end - Posição final da substring (não incluso, em caracteres)
+@param index - Índice criado para "str" por new_utf8_index (pode ser NULL)
+@return - 1 se executado com sucesso, 0 caso contrário
+*/
+short utf8_sub_string(String* str, String* target, int start, int end, Utf8Index* index) {
+    if (str == target || start > end)
+        return 0;
+
+    int byte_start = utf8_offset_string(str, start, index);
+    if (byte_start < 0)
+        return 0;
+
+    int byte_end = utf8_skip(str->c_str, str->lenght, byte_start, end - start);
+    if (byte_end < 0)
+        return 0;
+
+    return set_string_chars(target, str->c_str + byte_start, byte_end - byte_start);
+}
+
+/*
+Retorna o tamanho do array necessário para armazenar o resultado do
+método "utf8_split_string"
+
+@param str - Instância da String dinâmica em UTF-8 válido
+@param sep - Separador em UTF-8 válido
+@return - Tamanho do array que armazenará o resultado do split
+*/
+int utf8_size_split_string(String* str, const char* sep) {
+    if (sep[0] == '\0')
+        return utf8_length_string(str);
+
+    if (str->lenght == 0)
+        return 0;
+
+    int len_sep = strlen(sep);
+    int size = 1;
+    const char* it;
+    for (it = strstr(str->c_str, sep); it != NULL; it = strstr(it + len_sep, sep))
+        size++;
+
+    return size;
+}
+
+/*
+Igual ao "split_string", mas um separador vazio separa a String dinâmica em
+caracteres (code points) e não em bytes. Com um separador não vazio nenhum
+caractere é partido, pois em UTF-8 válido o separador não pode começar no
+meio de um caractere
+
+@param str - Instância da String dinâmica em UTF-8 válido
+@param target - Array que armazenará o resultado do split. O array deve
+    estar completamente desalocado da memória
+@param sep - Separador em UTF-8 válido
+@return - 1 se foi executado com sucesso, 0 caso contrário
+*/
+short utf8_split_string(String* str, String* target[], const char* sep) {
+    int i_target = 0;
+
+    if (sep[0] == '\0') {
+        int i = 0;
+        while (i < str->lenght) {
+            int size = MIN(utf8_char_size((unsigned char) str->c_str[i]), str->lenght - i);
+            target[i_target++] = new_string_chars(str->c_str + i, size);
+            i += size;
+        }
+        return 1;
+    }
+
+    if (str->lenght == 0)
+        return 1;
+
+    int len_sep = strlen(sep);
+    const char* start = str->c_str;
+    const char* it;
+    for (it = strstr(start, sep); it != NULL; it = strstr(start, sep)) {
+        target[i_target++] = new_string_chars(start, it - start);
+        start = it + len_sep;
+    }
+
+    target[i_target] = new_string_chars(start, str->c_str + str->lenght - start);
+    return 1;
+}